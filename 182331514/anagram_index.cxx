@@ -0,0 +1,99 @@
+#include "anagram_index.hxx"
+#include "embedded_dictionary.hxx"
+
+#include <algorithm>
+#include <utility>
+
+Anagram_index::Anagram_index(Word_bank const& bank)
+{
+    // Sort (signature, word) pairs, so each group is a run, in bank order.
+    std::vector<std::pair<uint64_t, uint32_t>> keyed;
+    keyed.reserve(bank.size());
+    for (size_t i = 0; i < bank.size(); ++i) {
+        uint64_t key = signature(bank[i]);
+        if (key != 0) {
+            keyed.push_back({key, uint32_t(i)});
+        }
+    }
+    std::sort(keyed.begin(), keyed.end());
+
+    words_.reserve(keyed.size());
+    groups_.reserve(keyed.size());
+
+    for (size_t i = 0; i < keyed.size(); ) {
+        size_t j = i;
+        while (j < keyed.size() && keyed[j].first == keyed[i].first) {
+            words_.push_back(bank[keyed[j].second]);
+            ++j;
+        }
+        groups_[keyed[i].first] = {uint32_t(i), uint32_t(j - i)};
+        i = j;
+    }
+}
+
+uint64_t
+Anagram_index::signature(std::string_view letters)
+{
+    if (letters.empty() || letters.size() > max_letters) {
+        return 0;
+    }
+
+    // Counting sort, since there are only 26 possible letters.
+    uint8_t counts[26] = {};
+    for (char c : letters) {
+        if (c < 'a' || c > 'z') {
+            return 0;
+        }
+        ++counts[c - 'a'];
+    }
+
+    uint64_t key = 0;
+    for (int c = 0; c < 26; ++c) {
+        for (int k = 0; k < counts[c]; ++k) {
+            key = key << 5 | uint64_t(c + 1);
+        }
+    }
+    return key;
+}
+
+Span<std::string_view>
+Anagram_index::anagrams(std::string_view letters) const
+{
+    auto found = groups_.find(signature(letters));
+    if (found == groups_.end()) {
+        return {};
+    }
+
+    return {words_.data() + found->second.begin, found->second.size};
+}
+
+size_t
+Anagram_index::size() const
+{
+    return words_.size();
+}
+
+size_t
+Anagram_index::group_count() const
+{
+    return groups_.size();
+}
+
+Anagram_index const&
+embedded_anagram_index(Word_list list)
+{
+    switch (list) {
+    case Word_list::short_list: {
+        static Anagram_index const index(embedded_word_bank(list));
+        return index;
+    }
+    case Word_list::long_list: {
+        static Anagram_index const index(embedded_word_bank(list));
+        return index;
+    }
+    default: {
+        static Anagram_index const index(embedded_word_bank(list));
+        return index;
+    }
+    }
+}
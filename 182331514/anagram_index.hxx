@@ -0,0 +1,60 @@
+#pragma once
+
+#include "dictionary.hxx"
+#include "span.hxx"
+#include "word_bank.hxx"
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// Groups the words of a word bank by the letters they use, so that "every
+/// word these tiles spell" is one hash lookup. For example, across both
+/// lists, the tiles of "least" also spell "slate", "stale", "steal",
+/// "tales" and seven other words.
+///
+/// The index holds views of the bank's words, so the bank it was built from
+/// must outlive it (the embedded banks always do).
+class Anagram_index
+{
+public:
+
+    /// Indexes every word of `bank`. Words longer than max_letters, or with
+    /// anything but the letters a-z in them, are left out.
+    explicit Anagram_index(Word_bank const& bank);
+
+    /// Longest word indexed.
+    static constexpr size_t max_letters = 12;
+
+    /// The letter signature of `letters`: the same for every arrangement of
+    /// the same letters, and different for different letters. It is the
+    /// letters, sorted, 5 bits each. Returns 0 for anything that can't be
+    /// indexed (see above).
+    static uint64_t signature(std::string_view letters);
+
+    /// Every indexed word spelled with exactly the letters of `letters`, in
+    /// bank order; empty if there are none.
+    Span<std::string_view> anagrams(std::string_view letters) const;
+
+    /// Number of words indexed, and number of distinct sets of letters.
+    size_t size() const;
+    size_t group_count() const;
+
+private:
+
+    /// All indexed words, grouped by signature.
+    std::vector<std::string_view> words_;
+
+    /// Where each signature's group starts in words_, and its length.
+    struct Group
+    {
+        uint32_t begin;
+        uint32_t size;
+    };
+    std::unordered_map<uint64_t, Group> groups_;
+};
+
+/// The index of embedded_word_bank(list), built the first time it's asked
+/// for and then shared (it is never modified, so any thread may use it).
+Anagram_index const& embedded_anagram_index(Word_list list);
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+// Bit counting on 64-bit words. GCC and Clang have builtins that compile to
+// single instructions; elsewhere we fall back to plain loops and shifts.
+
+#if defined(__GNUC__)
+#define BIT_OPS_BUILTINS 1
+#endif
+
+/// Number of set bits in `v`.
+inline int
+bit_count(uint64_t v)
+{
+#if defined(BIT_OPS_BUILTINS)
+    return __builtin_popcountll(v);
+#else
+    v = v - ((v >> 1) & 0x5555555555555555);
+    v = (v & 0x3333333333333333) + ((v >> 2) & 0x3333333333333333);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0F;
+    return int((v * 0x0101010101010101) >> 56);
+#endif
+}
+
+/// Position of the lowest set bit of `v` (`v` must be nonzero).
+inline int
+lowest_bit(uint64_t v)
+{
+#if defined(BIT_OPS_BUILTINS)
+    return __builtin_ctzll(v);
+#else
+    int result = 0;
+    while ((v & 1) == 0) {
+        v >>= 1;
+        ++result;
+    }
+    return result;
+#endif
+}
+
+/// Position of the highest set bit of `v` (`v` must be nonzero).
+inline int
+highest_bit(uint64_t v)
+{
+#if defined(BIT_OPS_BUILTINS)
+    return 63 - __builtin_clzll(v);
+#else
+    int result = 0;
+    while (v >>= 1) {
+        ++result;
+    }
+    return result;
+#endif
+}
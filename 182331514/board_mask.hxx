@@ -0,0 +1,107 @@
+#pragma once
+
+#include "bit_ops.hxx"
+
+#include <cstdint>
+
+/// A set of board cells stored as a bitboard: one bit per cell of a grid of
+/// up to 192 cells (the board is 15 x 11 = 165), packed into three 64-bit
+/// words. Cell (x, y) of a board `width` cells wide is bit y * width + x.
+class Board_mask
+{
+public:
+
+    static constexpr int capacity = 192;
+
+    constexpr Board_mask() : words_{0, 0, 0} { }
+
+    /// A mask with the first `count` cells set.
+    static constexpr Board_mask first(int count)
+    {
+        Board_mask result;
+        for (int i = 0; i < 3; ++i) {
+            int bits = count - 64 * i;
+            result.words_[i] = bits >= 64 ? ~uint64_t(0)
+                             : bits > 0   ? (uint64_t(1) << bits) - 1
+                             : 0;
+        }
+        return result;
+    }
+
+    constexpr bool test(int cell) const
+    {
+        return (words_[cell >> 6] >> (cell & 63)) & 1;
+    }
+
+    constexpr void set(int cell)
+    {
+        words_[cell >> 6] |= uint64_t(1) << (cell & 63);
+    }
+
+    constexpr void reset(int cell)
+    {
+        words_[cell >> 6] &= ~(uint64_t(1) << (cell & 63));
+    }
+
+    /// Number of cells in the set.
+    int count() const
+    {
+        return bit_count(words_[0]) +
+               bit_count(words_[1]) +
+               bit_count(words_[2]);
+    }
+
+    /// Calls `f(cell)` for each cell in the set, in increasing order.
+    template <class F>
+    void for_each(F f) const
+    {
+        for (int i = 0; i < 3; ++i) {
+            for (uint64_t w = words_[i]; w != 0; w &= w - 1) {
+                f(64 * i + lowest_bit(w));
+            }
+        }
+    }
+
+    constexpr Board_mask operator~() const
+    {
+        Board_mask result;
+        for (int i = 0; i < 3; ++i) {
+            result.words_[i] = ~words_[i];
+        }
+        return result;
+    }
+
+    constexpr Board_mask operator&(Board_mask other) const
+    {
+        Board_mask result;
+        for (int i = 0; i < 3; ++i) {
+            result.words_[i] = words_[i] & other.words_[i];
+        }
+        return result;
+    }
+
+    constexpr Board_mask operator|(Board_mask other) const
+    {
+        Board_mask result;
+        for (int i = 0; i < 3; ++i) {
+            result.words_[i] = words_[i] | other.words_[i];
+        }
+        return result;
+    }
+
+    constexpr bool operator==(Board_mask other) const
+    {
+        return words_[0] == other.words_[0] &&
+               words_[1] == other.words_[1] &&
+               words_[2] == other.words_[2];
+    }
+
+    constexpr bool operator!=(Board_mask other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+
+    uint64_t words_[3];
+};
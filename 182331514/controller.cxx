@@ -1,13 +1,53 @@
 #include "controller.hxx"
 
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+
+// How long the player must go without clicking or typing before frames are
+// throttled, and how long each throttled frame sleeps for. ge211 only takes
+// input between frames, so that sleep is also how much later than usual the
+// first click or key after an idle stretch can be handled: kept short, it
+// costs a few milliseconds once, where a 40 ms sleep was a visible lag.
+static double const idle_threshold = 0.25;
+static std::chrono::milliseconds const idle_sleep{10};
+
+// The word list played.
+static Word_list const game_word_list = Word_list::short_list;
+
+// A different game each run.
+static uint64_t
+fresh_seed_()
+{
+    std::random_device device;
+    return uint64_t(device()) << 32 | device();
+}
+
 //
 // CONSTRUCTOR
 //
 
-Controller::Controller()
-        : model_(),
-          view_(model_, mixer())
-{ }
+Controller::Controller(std::string const& record_path)
+        : seed_(fresh_seed_()),
+          model_(embedded_word_bank(game_word_list), seed_),
+          view_(model_, mixer()),
+          recorder_(),
+          idle_seconds_(0.0)
+{
+    // Any word that the tiles spell counts.
+    model_.set_anagram_index(&embedded_anagram_index(game_word_list));
+
+    // No word comes up twice until the player has seen them all.
+    model_.set_repeat_free(true);
+    model_.reset(seed_);
+
+    if (!record_path.empty()) {
+        recorder_ = std::make_unique<Input_recorder>(record_path, seed_,
+                                                     game_word_list,
+                                                     true, true);
+    }
+}
 
 //
 // FUNCTIONS
@@ -22,13 +62,29 @@ Controller::draw(ge211::Sprite_set& set)
 void
 Controller::on_frame(double dt)
 {
-    model_.on_frame(dt);
+    record_(Input_event::frame(dt));
+
+    // The model's Game_clock turns the real dt into whole 1/60000 s ticks
+    // and carries the rounding over, so the longer frames we get while
+    // throttled still count down the right amount of time.
+    model_.advance(dt);
+
+    // Idle means no input, not an unchanged model: the timer changes the
+    // model every second on its own.
+    idle_seconds_ += dt;
+
+    if (idle_seconds_ >= idle_threshold) {
+        std::this_thread::sleep_for(idle_sleep);
+    }
 }
 
 void
 Controller::on_mouse_down(ge211::Mouse_button, ge211::Posn<int> p)
 {
-    model_.click_letter(view_.screen_to_board(p));
+    Model::Position board_p = view_.screen_to_board(p);
+    record_(Input_event::click(board_p));
+    idle_seconds_ = 0.0;
+    model_.click_letter(board_p);
 
     if (!model_.is_correct()) {
         view_.play_whoosh_effect();
@@ -38,8 +94,12 @@ Controller::on_mouse_down(ge211::Mouse_button, ge211::Posn<int> p)
 void
 Controller::on_key(ge211::Key key)
 {
-    if (key == ge211::Key::code(' ')) {
-        model_.add_time_remaining(200);
+    record_(Input_event::key_press(key.code()));
+    idle_seconds_ = 0.0;
+    apply_key(model_, key.code());
+
+    if (profile_enabled && key == ge211::Key::code('p')) {
+        print_profile(std::cerr);
     }
 }
 
@@ -49,3 +109,15 @@ Controller::initial_window_dimensions() const
     return view_.initial_window_dimensions();
 }
 
+//
+// PRIVATE HELPER FUNCTIONS
+//
+
+void
+Controller::record_(Input_event const& event)
+{
+    if (recorder_) {
+        recorder_->record(event);
+    }
+}
+
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "input_log.hxx"
 #include "model.hxx"
 #include "view.hxx"
 
 #include <ge211.hxx>
+#include <memory>
+#include <string>
 
 class Controller : public ge211::Abstract_game
 {
@@ -14,7 +17,10 @@ public:
     // CONSTRUCTOR
     //
 
-    Controller();
+    /// Starts a game with a random seed. If `record_path` is not empty,
+    /// every frame, click and key press is also logged there (see
+    /// Input_recorder) so the session can be replayed later.
+    explicit Controller(std::string const& record_path = "");
 
 protected:
 
@@ -28,10 +34,13 @@ protected:
     /// Calls View's draw function.
     void draw(ge211::Sprite_set& set) override;
 
-    /// Updates model based on time passing.
+    /// Updates model based on time passing. Once the player has done
+    /// nothing for a while, it also sleeps a little each frame so an idle
+    /// game doesn't spin the CPU.
     void on_frame(double dt) override;
 
-    /// Updates model based on key presses.
+    /// Updates model based on key presses. In profiling builds, P also
+    /// prints the phase timings so far (see profile.hxx).
     void on_key(ge211::Key key) override;
 
     /// Initializes window dimensions, which is delegated to View.
@@ -43,6 +52,23 @@ private:
     // PRIVATE MEMBER VARIABLES
     //
 
+    // The seed the model started from. Declared before model_, which is
+    // built from it.
+    uint64_t seed_;
+
     Model model_;
     View view_;
+
+    // Logs the session when recording, otherwise null.
+    std::unique_ptr<Input_recorder> recorder_;
+
+    // How long (in seconds) since the last click or key press.
+    double idle_seconds_;
+
+    //
+    // PRIVATE HELPER FUNCTIONS
+    //
+
+    /// Logs `event` if recording.
+    void record_(Input_event const& event);
 };
@@ -0,0 +1,291 @@
+#include "dictionary.hxx"
+
+#include <ge211.hxx>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define WORD_SCRAMBLE_HAVE_MMAP 1
+#endif
+
+
+// Wordle Dictionaries pulled from GitHub.
+// Link: https://gist.github.com/scholtes/94f3c0303ba6a7768b47583aff36654d
+static std::string const short_dictionary{"wordle-La.txt"};
+static std::string const long_dictionary{"wordle-Ta.txt"};
+
+// Directories (relative to the working directory) that we look in for a
+// resource file, in order, before falling back to
+// ge211::open_resource_file(). Both ways of reading a file (mapping it or
+// not) and Dictionary::resource_path() search these the same way, so they
+// always agree on which copy of a file they mean.
+static char const* const resource_dirs[] = {"Resources/", "", "../Resources/"};
+
+// The first of resource_dirs that has `filename`, joined to it; empty if
+// none does.
+static std::string
+find_resource_(std::string const& filename)
+{
+    for (char const* dir : resource_dirs) {
+        std::string path = dir + filename;
+        if (std::ifstream(path)) {
+            return path;
+        }
+    }
+
+    return {};
+}
+
+//
+// MAPPED_FILE
+//
+
+#ifdef WORD_SCRAMBLE_HAVE_MMAP
+// Tries to map `path` read-only. Returns false (and leaves the out
+// parameters alone) if it cannot.
+static bool
+try_map_(std::string const& path, char const*& data, size_t& size)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* addr = ::mmap(nullptr, size_t(info.st_size), PROT_READ,
+                        MAP_PRIVATE, fd, 0);
+
+    // The mapping stays valid after the descriptor is closed.
+    ::close(fd);
+
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+
+    data = static_cast<char const*>(addr);
+    size = size_t(info.st_size);
+    return true;
+}
+#endif
+
+Mapped_file::Mapped_file(std::string const& filename, bool map)
+        : data_(nullptr),
+          size_(0),
+          mapped_(false),
+          buffer_()
+{
+    std::string const path = find_resource_(filename);
+
+#ifdef WORD_SCRAMBLE_HAVE_MMAP
+    if (map && !path.empty() && try_map_(path, data_, size_)) {
+        mapped_ = true;
+        return;
+    }
+#else
+    (void) map;
+#endif
+
+    // No mapping (available or wanted), so read the whole file into one
+    // buffer: the copy we found if there is one, or else whatever ge211
+    // finds.
+    std::ifstream stream = path.empty()
+                           ? ge211::open_resource_file(filename)
+                           : std::ifstream(path, std::ios::binary);
+
+    if (stream.bad()) {
+        throw std::runtime_error("could not read dictionary from: " +
+                                 filename);
+    }
+
+    buffer_.assign(std::istreambuf_iterator<char>(stream),
+                   std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+Mapped_file::Mapped_file(Mapped_file&& other) noexcept
+        : data_(other.data_),
+          size_(other.size_),
+          mapped_(other.mapped_),
+          buffer_(std::move(other.buffer_))
+{
+    if (!mapped_) {
+        data_ = buffer_.data();
+    }
+
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.mapped_ = false;
+}
+
+Mapped_file&
+Mapped_file::operator=(Mapped_file&& other) noexcept
+{
+    if (this != &other) {
+        release_();
+
+        data_ = other.data_;
+        size_ = other.size_;
+        mapped_ = other.mapped_;
+        buffer_ = std::move(other.buffer_);
+
+        if (!mapped_) {
+            data_ = buffer_.data();
+        }
+
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+    }
+
+    return *this;
+}
+
+Mapped_file::~Mapped_file()
+{
+    release_();
+}
+
+std::string_view
+Mapped_file::contents() const
+{
+    return {data_, size_};
+}
+
+bool
+Mapped_file::is_mapped() const
+{
+    return mapped_;
+}
+
+void
+Mapped_file::release_() noexcept
+{
+#ifdef WORD_SCRAMBLE_HAVE_MMAP
+    if (mapped_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    buffer_.clear();
+}
+
+
+//
+// DICTIONARY
+//
+
+Dictionary::Dictionary(Word_list list)
+        : files_(),
+          words_()
+{
+    // Reserve up front so that the files never move once words_ points
+    // into them.
+    files_.reserve(2);
+
+    if (list != Word_list::long_list) {
+        load_file_(short_dictionary);
+    }
+
+    if (list != Word_list::short_list) {
+        load_file_(long_dictionary);
+    }
+}
+
+size_t
+Dictionary::size() const
+{
+    return words_.size();
+}
+
+bool
+Dictionary::empty() const
+{
+    return words_.empty();
+}
+
+std::string_view
+Dictionary::operator[](size_t i) const
+{
+    return words_[i];
+}
+
+std::vector<std::string_view> const&
+Dictionary::words() const
+{
+    return words_;
+}
+
+std::vector<std::string_view>::const_iterator
+Dictionary::begin() const
+{
+    return words_.begin();
+}
+
+std::vector<std::string_view>::const_iterator
+Dictionary::end() const
+{
+    return words_.end();
+}
+
+std::string const&
+Dictionary::filename(Word_list list)
+{
+    if (list == Word_list::both) {
+        throw std::invalid_argument("Dictionary::filename: need one list");
+    }
+
+    return list == Word_list::short_list ? short_dictionary : long_dictionary;
+}
+
+std::string
+Dictionary::resource_path(std::string const& filename)
+{
+    std::string path = find_resource_(filename);
+    if (path.empty()) {
+        throw std::runtime_error("could not find dictionary: " + filename);
+    }
+
+    return path;
+}
+
+void
+Dictionary::load_file_(std::string const& filename)
+{
+    files_.emplace_back(filename);
+    std::string_view text = files_.back().contents();
+
+    // Every bundled word is five letters plus a newline, so this is close
+    // to exact and saves regrowing the index.
+    words_.reserve(words_.size() + text.size() / 6 + 1);
+
+    while (!text.empty()) {
+        size_t end = std::min(text.find('\n'), text.size());
+        std::string_view line = text.substr(0, end);
+        text.remove_prefix(std::min(end + 1, text.size()));
+
+        // Tolerate files saved with Windows line endings.
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+
+        if (!line.empty()) {
+            words_.push_back(line);
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Selects which of the bundled word lists to load.
+enum class Word_list
+{
+    /// wordle-La.txt: the ~2.3k common words (the original game list).
+    short_list,
+
+    /// wordle-Ta.txt: the ~10.6k less common words.
+    long_list,
+
+    /// Both of the lists above, short list first.
+    both,
+};
+
+/// A read-only view of a whole resource file. Where the platform allows it,
+/// the file is memory-mapped so that nothing is copied onto the heap;
+/// otherwise it is read into a single buffer.
+///
+/// The file is looked for relative to the working directory in Resources/,
+/// then the working directory itself, then ../Resources/, and only if none
+/// has it through ge211::open_resource_file() (which may search elsewhere,
+/// and can't be mapped). The first copy found is used whether or not it
+/// gets mapped.
+class Mapped_file
+{
+public:
+
+    /// Opens and maps the resource file `filename`, or if `map` is false
+    /// reads it into a buffer as if mapping were unavailable. Throws
+    /// std::runtime_error if the file cannot be found or read.
+    explicit Mapped_file(std::string const& filename, bool map = true);
+
+    Mapped_file(Mapped_file&& other) noexcept;
+    Mapped_file& operator=(Mapped_file&& other) noexcept;
+
+    Mapped_file(Mapped_file const&) = delete;
+    Mapped_file& operator=(Mapped_file const&) = delete;
+
+    ~Mapped_file();
+
+    /// The bytes of the file. Valid for as long as this object lives.
+    std::string_view contents() const;
+
+    /// Whether the contents are memory-mapped (as opposed to copied).
+    bool is_mapped() const;
+
+private:
+
+    char const* data_;
+    size_t size_;
+    bool mapped_;
+
+    /// Only used when mapping is not available.
+    std::string buffer_;
+
+    /// Unmaps the file (if mapped) and resets to empty.
+    void release_() noexcept;
+};
+
+/// A word list loaded from the bundled resource files. Words are exposed
+/// as std::string_views pointing straight into the mapped files, so loading
+/// does one allocation for the index rather than one per word.
+class Dictionary
+{
+public:
+
+    /// Loads the given word list(s). Throws std::runtime_error if a resource
+    /// file cannot be read.
+    explicit Dictionary(Word_list list = Word_list::short_list);
+
+    /// Number of words loaded.
+    size_t size() const;
+
+    bool empty() const;
+
+    /// The i-th word. Valid for as long as this Dictionary lives.
+    std::string_view operator[](size_t i) const;
+
+    /// All of the words, in file order.
+    std::vector<std::string_view> const& words() const;
+
+    std::vector<std::string_view>::const_iterator begin() const;
+    std::vector<std::string_view>::const_iterator end() const;
+
+    /// The resource file name of the given bundled list. `list` must not be
+    /// Word_list::both.
+    static std::string const& filename(Word_list list);
+
+    /// Where the resource file `filename` is, relative to the working
+    /// directory: the copy Mapped_file would use, found the same way but
+    /// without ge211's fallback. Throws std::runtime_error if there's none.
+    static std::string resource_path(std::string const& filename);
+
+private:
+
+    std::vector<Mapped_file> files_;
+    std::vector<std::string_view> words_;
+
+    /// Maps one resource file and appends its words to words_.
+    void load_file_(std::string const& filename);
+};
@@ -0,0 +1,25 @@
+#include "draw_list.hxx"
+
+Draw_list&
+Draw_list::add_sprite(ge211::Sprite const& sprite,
+                      ge211::Posn<int> xy,
+                      int z,
+                      ge211::Transform const& transform)
+{
+    placements_.push_back({&sprite, xy, z, transform});
+    return *this;
+}
+
+void
+Draw_list::clear()
+{
+    placements_.clear();
+}
+
+void
+Draw_list::replay(ge211::Sprite_set& set) const
+{
+    for (Placement const& p : placements_) {
+        set.add_sprite(*p.sprite, p.xy, p.z, p.transform);
+    }
+}
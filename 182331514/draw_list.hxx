@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ge211.hxx>
+
+#include <vector>
+
+/// A retained list of sprite placements. It has the same add_sprite()
+/// interface as ge211::Sprite_set, so drawing code can record a frame into
+/// it once and then replay that frame into ge211's Sprite_set on every frame
+/// until something changes. The sprites are not copied, so they must outlive
+/// the list (or at least the next clear()).
+class Draw_list
+{
+public:
+
+    /// Records one placement, exactly as ge211::Sprite_set::add_sprite().
+    Draw_list& add_sprite(ge211::Sprite const& sprite,
+                          ge211::Posn<int> xy,
+                          int z = 0,
+                          ge211::Transform const& transform =
+                                  ge211::Transform());
+
+    /// Forgets all the placements (keeping the memory for reuse).
+    void clear();
+
+    /// Adds every recorded placement to `set`, in the order recorded.
+    void replay(ge211::Sprite_set& set) const;
+
+private:
+
+    struct Placement
+    {
+        ge211::Sprite const* sprite;
+        ge211::Posn<int> xy;
+        int z;
+        ge211::Transform transform;
+    };
+
+    std::vector<Placement> placements_;
+};
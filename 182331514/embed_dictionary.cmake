@@ -0,0 +1,100 @@
+# Turns the bundled word lists into a C++ header with a constexpr packed
+# table, so the program needs no dictionary files at runtime.
+#
+# Usage (run by the build, see CMakeLists.txt):
+#
+#   cmake -DINPUT_DIR=<dir with wordle-*.txt> -DOUTPUT=<header> \
+#         -P embed_dictionary.cmake
+
+cmake_minimum_required(VERSION 3.3)
+
+if(NOT INPUT_DIR OR NOT OUTPUT)
+    message(FATAL_ERROR "embed_dictionary.cmake: set INPUT_DIR and OUTPUT")
+endif()
+
+set(WORD_WIDTH 5)
+
+# Reads one list, checks that every word is WORD_WIDTH lowercase letters,
+# and sets <prefix>_COUNT and <prefix>_LINES (the string literal lines).
+function(embed_list filename prefix)
+    file(STRINGS "${INPUT_DIR}/${filename}" words)
+
+    set(count 0)
+    set(line "")
+    set(lines "")
+
+    foreach(word IN LISTS words)
+        string(STRIP "${word}" word)
+        if(word STREQUAL "")
+            continue()
+        endif()
+
+        if(NOT word MATCHES "^[a-z]+$")
+            message(FATAL_ERROR "${filename}: bad word '${word}'")
+        endif()
+
+        string(LENGTH "${word}" length)
+        if(NOT length EQUAL WORD_WIDTH)
+            message(FATAL_ERROR
+                    "${filename}: '${word}' is not ${WORD_WIDTH} letters")
+        endif()
+
+        string(APPEND line "${word}")
+        math(EXPR count "${count} + 1")
+
+        # Sixteen words (80 characters) per line of output.
+        math(EXPR column "${count} % 16")
+        if(column EQUAL 0)
+            string(APPEND lines "        \"${line}\"\n")
+            set(line "")
+        endif()
+    endforeach()
+
+    if(NOT line STREQUAL "")
+        string(APPEND lines "        \"${line}\"\n")
+    endif()
+
+    set(${prefix}_COUNT ${count} PARENT_SCOPE)
+    set(${prefix}_LINES "${lines}" PARENT_SCOPE)
+endfunction()
+
+embed_list(wordle-La.txt SHORT)
+embed_list(wordle-Ta.txt LONG)
+
+set(contents "// Generated by embed_dictionary.cmake from wordle-La.txt and
+// wordle-Ta.txt. Do not edit.
+
+#pragma once
+
+#include <cstddef>
+
+namespace dictionary_data {
+
+/// Every word in both lists has this many letters.
+constexpr std::size_t word_width = ${WORD_WIDTH};
+
+/// Number of words from wordle-La.txt (stored first).
+constexpr std::size_t short_count = ${SHORT_COUNT};
+
+/// Number of words from wordle-Ta.txt (stored after the short list).
+constexpr std::size_t long_count = ${LONG_COUNT};
+
+/// All the words as fixed-width records with no separators.
+constexpr char letters[] =
+${SHORT_LINES}${LONG_LINES}        \"\";
+
+static_assert(sizeof(letters) - 1 ==
+              word_width * (short_count + long_count),
+              \"dictionary table has the wrong size\");
+
+} // end namespace dictionary_data
+")
+
+# Only touch the header when it actually changes, to avoid rebuilds.
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" old_contents)
+endif()
+
+if(NOT old_contents STREQUAL contents)
+    file(WRITE "${OUTPUT}" "${contents}")
+endif()
@@ -0,0 +1,24 @@
+#include "embedded_dictionary.hxx"
+
+// Generated by the build from wordle-La.txt and wordle-Ta.txt.
+#include "dictionary_data.hxx"
+
+Word_bank
+embedded_word_bank(Word_list list)
+{
+    using namespace dictionary_data;
+
+    size_t const short_size = word_width * short_count;
+    size_t const long_size = word_width * long_count;
+    std::string_view const all(letters, short_size + long_size);
+
+    switch (list) {
+    case Word_list::short_list:
+        return Word_bank::view_fixed(all.substr(0, short_size), word_width);
+    case Word_list::long_list:
+        return Word_bank::view_fixed(all.substr(short_size), word_width);
+    case Word_list::both:
+    default:
+        return Word_bank::view_fixed(all, word_width);
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "dictionary.hxx"
+#include "word_bank.hxx"
+
+/// Returns the bundled word list(s) that the build compiled into the program
+/// (see embed_dictionary.cmake). This does no I/O and no parsing, and cannot
+/// fail: the result is a view of static storage, so it also costs no
+/// allocation.
+Word_bank embedded_word_bank(Word_list list);
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+/// Game time, in fixed point: whole ticks of 1/60000 of a second. A 60 Hz
+/// frame is exactly 1000 ticks and a millisecond exactly 60, so the game's
+/// old frame-based times (a word lasts 960 frames) are still exact, while
+/// frames at any other rate lose no more than a tick.
+using Game_time = std::chrono::duration<int64_t, std::ratio<1, 60000>>;
+
+/// One 60 Hz frame.
+constexpr Game_time frame_time{1000};
+
+/// Turns real time, which arrives as seconds in a double, into Game_time
+/// at an adjustable rate (the time scale: 2 runs the game twice as fast, 0
+/// pauses it). Rounds each step to whole ticks and carries the rounding
+/// into the next step, so many small steps add up to what one big step of
+/// the same total would, and a game's clock never drifts from real time.
+class Game_clock
+{
+public:
+
+    /// `scale` must not be negative.
+    explicit Game_clock(double scale = 1.0)
+            : scale_(scale),
+              carry_(0.0)
+    { }
+
+    double scale() const { return scale_; }
+    void set_scale(double scale) { scale_ = scale; }
+
+    /// The game time that passes in `seconds` of real time. Never
+    /// negative: time that goes backwards (or isn't a number) is ignored.
+    Game_time tick(double seconds)
+    {
+        if (!(seconds > 0)) {
+            return Game_time::zero();
+        }
+
+        double const ticks = seconds * scale_ * Game_time::period::den +
+                             carry_;
+        double const whole = std::max(0.0, std::round(ticks));
+        carry_ = ticks - whole;
+        return Game_time(int64_t(whole));
+    }
+
+    /// Forgets the carried rounding (for a new game).
+    void reset() { carry_ = 0.0; }
+
+private:
+
+    double scale_;
+
+    /// Ticks passed but not yet handed out, from -0.5 to 0.5.
+    double carry_;
+};
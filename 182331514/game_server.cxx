@@ -0,0 +1,618 @@
+#include "game_server.hxx"
+#include "input_log.hxx"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+// Most epoll events handled per wait.
+static int const max_events = 256;
+
+// A client that lets this much output pile up unread is disconnected.
+static size_t const max_output = 64 * 1024;
+
+// Bytes read from a socket at a time.
+static size_t const read_chunk = 4096;
+
+// Reads from one socket per event, so a client that floods us can't keep
+// the loop to itself. epoll is level-triggered: whatever is left over is
+// reported again on the next wait.
+static int const max_reads = 4;
+
+// Size of a session's input buffer, reserved up front. Messages are applied
+// after every read, so all it ever holds between reads is the start of one
+// (tiny) message; a client that leaves it full is disconnected.
+static size_t const max_input = read_chunk;
+
+// Slots in the fd-indexed session table beyond one per prebuilt session.
+static size_t const fd_headroom = 64;
+
+static std::system_error
+system_error_(char const* what)
+{
+    return std::system_error(errno, std::generic_category(), what);
+}
+
+//
+// SESSIONS
+//
+
+Game_server::Session::Session(int fd, Model model)
+        : fd(fd),
+          model(std::move(model)),
+          sent_version(0),
+          sent_posns(),
+          input(),
+          output(),
+          waiting_to_write(false)
+{ }
+
+void
+Game_server::Session::reuse(int new_fd, uint64_t seed)
+{
+    fd = new_fd;
+    model.reset(seed);
+    sent_version = 0;
+    sent_posns.clear();
+    input.clear();
+    output.clear();
+    waiting_to_write = false;
+}
+
+//
+// CONSTRUCTOR
+//
+
+Game_server::Game_server(Server_config const& config)
+        : config_(config),
+          word_bank_(embedded_word_bank(config.list)),
+          anagrams_(config.anagrams ? &embedded_anagram_index(config.list)
+                                    : nullptr),
+          selector_(config.difficulty
+                    ? &embedded_word_selector(config.list, *config.difficulty)
+                    : nullptr),
+          seed_state_(config.seed),
+          word_source_(config.watch_words
+                       ? std::make_unique<Word_source>(config.list)
+                       : nullptr),
+          listen_fd_(-1),
+          epoll_fd_(-1),
+          timer_fd_(-1),
+          accepting_(true),
+          stopping_(false),
+          session_arena_(),
+          free_sessions_(),
+          sessions_(),
+          session_count_(0),
+          last_tick_(clock::now())
+{
+    if (word_source_) {
+        word_source_->watch();
+    }
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        throw system_error_("epoll_create1");
+    }
+
+    listen_fd_ = open_listener_();
+
+    timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd_ < 0) {
+        throw system_error_("timerfd_create");
+    }
+
+    long const tick_ns = 1000000000L / std::max(1, config_.tick_rate);
+    itimerspec interval{};
+    interval.it_interval.tv_sec = tick_ns / 1000000000L;
+    interval.it_interval.tv_nsec = tick_ns % 1000000000L;
+    interval.it_value = interval.it_interval;
+    if (timerfd_settime(timer_fd_, 0, &interval, nullptr) < 0) {
+        throw system_error_("timerfd_settime");
+    }
+
+    for (int fd : {listen_fd_, timer_fd_}) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+            throw system_error_("epoll_ctl");
+        }
+    }
+
+    // Build the sessions now, with room in their buffers for a full read.
+    // sessions_ is indexed by fd, and the process has other fds open too
+    // (stdio, epoll, the timer, a word-list watcher), so leave headroom.
+    free_sessions_.reserve(config_.preallocate);
+    sessions_.reserve(config_.preallocate + fd_headroom);
+    for (size_t i = 0; i < config_.preallocate; ++i) {
+        session_arena_.emplace_back(-1, new_model_());
+        Session& session = session_arena_.back();
+        session.input.reserve(max_input);
+        session.output.reserve(read_chunk);
+        free_sessions_.push_back(&session);
+    }
+}
+
+Game_server::~Game_server()
+{
+    for (Session* session : sessions_) {
+        if (session) {
+            ::close(session->fd);
+        }
+    }
+
+    for (int fd : {timer_fd_, listen_fd_, epoll_fd_}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    if (!config_.unix_path.empty()) {
+        ::unlink(config_.unix_path.c_str());
+    }
+}
+
+//
+// PUBLIC FUNCTIONS
+//
+
+void
+Game_server::run()
+{
+    epoll_event events[max_events];
+
+    last_tick_ = clock::now();
+
+    while (!stopping_.load()) {
+        int n = epoll_wait(epoll_fd_, events, max_events, -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw system_error_("epoll_wait");
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            uint32_t what = events[i].events;
+
+            if (fd == listen_fd_) {
+                accept_all_();
+                continue;
+            }
+
+            if (fd == timer_fd_) {
+                tick_();
+                continue;
+            }
+
+            // (It may have been closed by an earlier event in this batch.)
+            if (size_t(fd) >= sessions_.size() || !sessions_[size_t(fd)]) {
+                continue;
+            }
+            Session& session = *sessions_[size_t(fd)];
+
+            if (what & (EPOLLERR | EPOLLHUP)) {
+                close_(session);
+                continue;
+            }
+
+            if (what & EPOLLIN) {
+                read_from_(session);
+
+                // (Reading may have closed it.)
+                if (!sessions_[size_t(fd)]) {
+                    continue;
+                }
+            }
+
+            if ((what & EPOLLOUT) && !flush_(session)) {
+                close_(session);
+            }
+        }
+    }
+}
+
+void
+Game_server::stop()
+{
+    stopping_.store(true);
+}
+
+size_t
+Game_server::session_count() const
+{
+    return session_count_;
+}
+
+//
+// PRIVATE HELPER FUNCTIONS
+//
+
+int
+Game_server::open_listener_()
+{
+    int fd;
+
+    if (!config_.unix_path.empty()) {
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            throw system_error_("socket");
+        }
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (config_.unix_path.size() >= sizeof address.sun_path) {
+            ::close(fd);
+            throw std::system_error(ENAMETOOLONG, std::generic_category(),
+                                    "socket path");
+        }
+        std::strcpy(address.sun_path, config_.unix_path.c_str());
+        ::unlink(address.sun_path);
+
+        if (bind(fd, reinterpret_cast<sockaddr*>(&address),
+                 sizeof address) < 0)
+        {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            throw system_error_("bind");
+        }
+    } else {
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            throw system_error_("socket");
+        }
+
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof one);
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(uint16_t(config_.port));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (bind(fd, reinterpret_cast<sockaddr*>(&address),
+                 sizeof address) < 0)
+        {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            throw system_error_("bind");
+        }
+    }
+
+    if (listen(fd, SOMAXCONN) < 0) {
+        int error = errno;
+        ::close(fd);
+        errno = error;
+        throw system_error_("listen");
+    }
+
+    return fd;
+}
+
+void
+Game_server::accept_all_()
+{
+    for (;;) {
+        int fd = accept4(listen_fd_, nullptr, nullptr,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            switch (errno) {
+            case EAGAIN:
+#if EWOULDBLOCK != EAGAIN
+            case EWOULDBLOCK:
+#endif
+                // No more pending.
+                return;
+
+            case EINTR:
+            case ECONNABORTED:
+            case EPROTO:
+            case EPERM:
+                // Only this connection failed (or none did); try the next.
+                continue;
+
+            default:
+                // Out of file descriptors (EMFILE, ENFILE) or memory. The
+                // connection stays pending, so stop listening for it until
+                // a session closes or the next tick, rather than spin.
+                set_accepting_(false);
+                return;
+            }
+        }
+
+        if (config_.unix_path.empty()) {
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+            ::close(fd);
+            continue;
+        }
+
+        Session& session = open_session_(fd);
+        if (!queue_update_(session) || !flush_(session)) {
+            close_(session);
+        }
+    }
+}
+
+void
+Game_server::set_accepting_(bool accepting)
+{
+    if (accepting == accepting_) {
+        return;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listen_fd_;
+    if (epoll_ctl(epoll_fd_, accepting ? EPOLL_CTL_ADD : EPOLL_CTL_DEL,
+                  listen_fd_, &event) == 0) {
+        accepting_ = accepting;
+    }
+}
+
+Model
+Game_server::new_model_()
+{
+    uint64_t seed = next_seed_();
+    Model model(word_bank_, seed);
+    model.set_anagram_index(anagrams_);
+    model.set_repeat_free(config_.repeat_free);
+    model.set_word_source(word_source_.get());
+    if (selector_ || config_.repeat_free || word_source_) {
+        model.set_word_selector(selector_);
+        model.reset(seed);
+    }
+    return model;
+}
+
+Game_server::Session&
+Game_server::open_session_(int fd)
+{
+    Session* session;
+
+    if (free_sessions_.empty()) {
+        session_arena_.emplace_back(fd, new_model_());
+        session = &session_arena_.back();
+    } else {
+        session = free_sessions_.back();
+        free_sessions_.pop_back();
+        session->reuse(fd, next_seed_());
+    }
+
+    if (size_t(fd) >= sessions_.size()) {
+        sessions_.resize(size_t(fd) + 1);
+    }
+    sessions_[size_t(fd)] = session;
+    ++session_count_;
+
+    return *session;
+}
+
+void
+Game_server::tick_()
+{
+    uint64_t expirations;
+    if (::read(timer_fd_, &expirations, sizeof expirations) < 0) {
+        return;
+    }
+
+    // Try accepting again, in case descriptors were freed elsewhere.
+    set_accepting_(true);
+
+    clock::time_point now = clock::now();
+    std::chrono::duration<double> dt = now - last_tick_;
+    last_tick_ = now;
+
+    // One pass over every session: advance it, then send what changed.
+    for (Session* slot : sessions_) {
+        if (!slot) {
+            continue;
+        }
+
+        Session& session = *slot;
+        session.model.advance(dt.count());
+
+        if (!queue_update_(session) ||
+            (!session.waiting_to_write && !flush_(session))) {
+            close_(session);
+        }
+    }
+}
+
+void
+Game_server::read_from_(Session& session)
+{
+    for (int reads = 0; reads < max_reads; ++reads) {
+        // Only ever read into the space already reserved.
+        size_t const old_size = session.input.size();
+        if (old_size >= max_input) {
+            close_(session);
+            return;
+        }
+        size_t const room = max_input - old_size;
+        session.input.resize(max_input);
+
+        ssize_t n = ::recv(session.fd, &session.input[old_size], room, 0);
+        session.input.resize(old_size + size_t(std::max<ssize_t>(n, 0)));
+
+        if (n == 0) {
+            close_(session);
+            return;
+        }
+
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            close_(session);
+            return;
+        }
+
+        if (!apply_input_(session)) {
+            close_(session);
+            return;
+        }
+    }
+
+    if (!queue_update_(session) ||
+        (!session.waiting_to_write && !flush_(session))) {
+        close_(session);
+    }
+}
+
+bool
+Game_server::apply_input_(Session& session)
+{
+    // Apply every whole message; keep any partial one for next time.
+    size_t used = 0;
+    Client_message message;
+    for (;;) {
+        Decode_result n = decode_client_message(session.input.data() + used,
+                                                session.input.size() - used,
+                                                message);
+        if (n < 0) {
+            return false;
+        }
+        if (n == 0) {
+            break;
+        }
+
+        apply_(session, message);
+        used += size_t(n);
+    }
+    session.input.erase(0, used);
+
+    return true;
+}
+
+void
+Game_server::apply_(Session& session, Client_message const& message)
+{
+    switch (message.type) {
+    case Client_message::Type::click:
+        session.model.click_letter(message.posn);
+        break;
+
+    case Client_message::Type::key:
+        apply_key(session.model, message.key);
+        break;
+
+    case Client_message::Type::new_game:
+        // In place, so no memory is freed or allocated.
+        session.model.reset(message.seed ? message.seed : next_seed_());
+        session.sent_posns.clear();
+        break;
+    }
+}
+
+bool
+Game_server::queue_update_(Session& session)
+{
+    Model const& model = session.model;
+    bool const new_word = session.sent_posns.empty() ||
+                          model.full_word_posns() != session.sent_posns;
+
+    if (!new_word && model.version() == session.sent_version) {
+        return true;
+    }
+
+    if (new_word) {
+        encode_snapshot(model, session.output);
+        Span<Model::Position> posns = model.full_word_posns();
+        session.sent_posns.assign(posns.begin(), posns.end());
+    } else {
+        encode_delta(model, session.output);
+    }
+
+    session.sent_version = model.version();
+
+    // Checked here as well as in flush_(), which isn't called while we wait
+    // for the socket: a client that stops reading must not make us queue
+    // updates for it forever.
+    return session.output.size() <= max_output;
+}
+
+bool
+Game_server::flush_(Session& session)
+{
+    size_t sent = 0;
+
+    while (sent < session.output.size()) {
+        ssize_t n = ::send(session.fd, session.output.data() + sent,
+                           session.output.size() - sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return false;
+        }
+        sent += size_t(n);
+    }
+
+    session.output.erase(0, sent);
+
+    if (session.output.size() > max_output) {
+        return false;
+    }
+
+    // Only ask to hear about writability while there's something to write.
+    bool const waiting = !session.output.empty();
+    if (waiting != session.waiting_to_write) {
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | (waiting ? uint32_t(EPOLLOUT) : 0u);
+        event.data.fd = session.fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, session.fd, &event) < 0) {
+            return false;
+        }
+        session.waiting_to_write = waiting;
+    }
+
+    return true;
+}
+
+void
+Game_server::close_(Session& session)
+{
+    int fd = session.fd;
+
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+
+    sessions_[size_t(fd)] = nullptr;
+    --session_count_;
+    free_sessions_.push_back(&session);
+
+    // That freed a descriptor, so a connection left pending can have it.
+    set_accepting_(true);
+}
+
+uint64_t
+Game_server::next_seed_()
+{
+    return splitmix64(seed_state_);
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "model.hxx"
+#include "protocol.hxx"
+#include "word_source.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/// Where and how a Game_server runs.
+struct Server_config
+{
+    /// Listen on this Unix socket path if it's not empty, otherwise on
+    /// TCP `port` on the loopback interface.
+    std::string unix_path;
+    int port = 7211;
+
+    /// Word list played, and the seed new sessions' seeds are drawn from.
+    Word_list list = Word_list::short_list;
+    uint64_t seed = 1;
+
+    /// Whether players may spell any word their tiles make (see
+    /// Model::set_anagram_index()).
+    bool anagrams = false;
+
+    /// Favor words of this difficulty (see word_selection.hxx); by default
+    /// words are picked uniformly.
+    std::optional<Difficulty> difficulty;
+
+    /// Whether each session deals words without repeats (see
+    /// Model::set_repeat_free()). Costs nothing per session beyond a key
+    /// and a counter.
+    bool repeat_free = false;
+
+    /// Read the word list from its files rather than the compiled-in copy,
+    /// and reload it whenever the files change (see Word_source). Games in
+    /// progress move onto the new words at their next word, so updating the
+    /// list doesn't mean restarting the server.
+    bool watch_words = false;
+
+    /// How many times per second all sessions are ticked.
+    int tick_rate = 60;
+
+    /// Sessions built up front. Sessions are recycled, never freed, so a
+    /// server that never has more than this many clients at once doesn't
+    /// allocate memory for them (except to grow the table of sessions by
+    /// fd, if the process has unusually many other files open).
+    size_t preallocate = 0;
+};
+
+/// Hosts one game (Model) per client connection in a single thread, driven
+/// by an epoll event loop, speaking the protocol in protocol.hxx.
+///
+/// Clicks and keys are applied as soon as they're read, and the reply goes
+/// out in the same pass, so a click's latency is one socket read and one
+/// write. Time is handled by a single timer: each tick advances every
+/// session in one pass over them, and only sessions whose version() has
+/// changed are sent anything.
+class Game_server
+{
+public:
+
+    /// Opens the listening socket, epoll instance and tick timer. Throws
+    /// std::system_error if any of them fails.
+    explicit Game_server(Server_config const& config);
+
+    ~Game_server();
+
+    Game_server(Game_server const&) = delete;
+    Game_server& operator=(Game_server const&) = delete;
+
+    /// Serves until stop() is called.
+    void run();
+
+    /// Makes run() return. Safe to call from a signal handler.
+    void stop();
+
+    /// Number of connected sessions.
+    size_t session_count() const;
+
+private:
+
+    using clock = std::chrono::steady_clock;
+
+    /// One client's game: either connected, or disconnected and waiting in
+    /// free_sessions_ for the next client.
+    struct Session
+    {
+        Session(int fd, Model model);
+
+        /// Makes a recycled session ready for a new client, keeping its
+        /// memory.
+        void reuse(int fd, uint64_t seed);
+
+        int fd;
+        Model model;
+
+        /// What the client was last sent: the model version, and the
+        /// positions of the word (so a new word is noticed even if it has
+        /// the same letters).
+        uint64_t sent_version;
+        std::vector<Model::Position> sent_posns;
+
+        /// Bytes read but not yet a whole message, and bytes waiting for
+        /// the socket to accept them.
+        std::string input;
+        std::string output;
+        bool waiting_to_write;
+    };
+
+    Server_config config_;
+    Word_bank word_bank_;
+    Anagram_index const* anagrams_;
+    Word_selector const* selector_;
+    uint64_t seed_state_;
+
+    /// The reloadable word lists if config_.watch_words, else null. Every
+    /// session's Model holds a reference into it, so it is declared before
+    /// the sessions, to be destroyed after them.
+    std::unique_ptr<Word_source> word_source_;
+
+    int listen_fd_;
+    int epoll_fd_;
+    int timer_fd_;
+
+    /// Whether listen_fd_ is in the epoll set. It is taken out while we're
+    /// out of file descriptors, since a pending connection we can't accept
+    /// would otherwise wake epoll_wait() over and over.
+    bool accepting_;
+    std::atomic<bool> stopping_;
+
+    /// Every session ever made, connected or not. A deque never moves its
+    /// elements, so the pointers below stay valid as it grows, and it
+    /// allocates in chunks rather than per session.
+    std::deque<Session> session_arena_;
+
+    /// Sessions in session_arena_ that aren't connected, ready for reuse.
+    std::vector<Session*> free_sessions_;
+
+    /// Connected sessions indexed by file descriptor (descriptors are small
+    /// and reused, so this stays dense); null where there is none.
+    std::vector<Session*> sessions_;
+    size_t session_count_;
+
+    clock::time_point last_tick_;
+
+    //
+    // PRIVATE HELPER FUNCTIONS
+    //
+
+    /// Creates the listening socket described by config_.
+    int open_listener_();
+
+    /// Accepts every pending connection, or as many as there are file
+    /// descriptors for.
+    void accept_all_();
+
+    /// Adds listen_fd_ to the epoll set, or takes it out.
+    void set_accepting_(bool accepting);
+
+    /// A new Model with the server's word bank and rules.
+    Model new_model_();
+
+    /// A session for a new client on `fd`: a recycled one if there is one,
+    /// otherwise a new one.
+    Session& open_session_(int fd);
+
+    /// Advances every session to now, and sends out what changed.
+    void tick_();
+
+    /// Reads and applies everything a session has sent.
+    void read_from_(Session& session);
+
+    /// Applies the whole messages in a session's input, keeping any partial
+    /// one. Returns false if the input is malformed.
+    bool apply_input_(Session& session);
+
+    /// Applies one message to a session.
+    void apply_(Session& session, Client_message const& message);
+
+    /// Queues a snapshot or delta if the session's model has changed.
+    /// Returns false if the client has left too much output unread, and
+    /// so should be disconnected.
+    bool queue_update_(Session& session);
+
+    /// Writes as much queued output as the socket takes. Returns false if
+    /// the connection has failed.
+    bool flush_(Session& session);
+
+    /// Disconnects a session and puts it back for reuse.
+    void close_(Session& session);
+
+    /// A seed for the next new game.
+    uint64_t next_seed_();
+};
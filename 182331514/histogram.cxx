@@ -0,0 +1,256 @@
+#include "histogram.hxx"
+#include "bit_ops.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+//
+// CONSTRUCTOR
+//
+
+Histogram::Histogram(int precision)
+        : precision_(precision),
+          buckets_(),
+          count_(0),
+          min_(std::numeric_limits<uint64_t>::max()),
+          max_(0),
+          total_(0)
+{
+    if (precision < 1 || precision > 10) {
+        throw std::invalid_argument("Histogram: precision must be 1 to 10");
+    }
+
+    // One exact group below 2^precision, then one group per remaining
+    // power of two.
+    buckets_.assign(size_t(65 - precision) << precision, 0);
+}
+
+//
+// RECORDING
+//
+
+void
+Histogram::record(uint64_t value)
+{
+    record(value, 1);
+}
+
+void
+Histogram::record(uint64_t value, uint64_t count)
+{
+    buckets_[bucket_index(value)] += count;
+    count_ += count;
+    total_ += (long double) value * count;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+void
+Histogram::merge(Histogram const& other)
+{
+    if (other.precision_ != precision_) {
+        throw std::invalid_argument("Histogram::merge: precision mismatch");
+    }
+
+    for (size_t i = 0; i < buckets_.size(); ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+
+    count_ += other.count_;
+    total_ += other.total_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void
+Histogram::clear()
+{
+    std::fill(buckets_.begin(), buckets_.end(), 0);
+    count_ = 0;
+    min_ = std::numeric_limits<uint64_t>::max();
+    max_ = 0;
+    total_ = 0;
+}
+
+//
+// QUERIES
+//
+
+uint64_t
+Histogram::count() const
+{
+    return count_;
+}
+
+uint64_t
+Histogram::min() const
+{
+    return count_ == 0 ? 0 : min_;
+}
+
+uint64_t
+Histogram::max() const
+{
+    return max_;
+}
+
+double
+Histogram::mean() const
+{
+    return count_ == 0 ? 0.0 : double(total_ / count_);
+}
+
+uint64_t
+Histogram::percentile(double percent) const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+
+    double wanted = std::ceil(percent / 100.0 * double(count_));
+    uint64_t target = std::max(uint64_t(1), uint64_t(wanted));
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < buckets_.size(); ++i) {
+        seen += buckets_[i];
+        if (seen >= target) {
+            return std::min(std::max(bucket_upper_bound(i), min()), max_);
+        }
+    }
+
+    return max_;
+}
+
+void
+Histogram::print_summary(std::ostream& os, double scale) const
+{
+    os << "n=" << count()
+       << " mean=" << mean() / scale
+       << " min=" << double(min()) / scale
+       << " p50=" << double(percentile(50)) / scale
+       << " p90=" << double(percentile(90)) / scale
+       << " p99=" << double(percentile(99)) / scale
+       << " max=" << double(max()) / scale;
+}
+
+int
+Histogram::precision() const
+{
+    return precision_;
+}
+
+//
+// BUCKET ACCESS
+//
+
+size_t
+Histogram::bucket_count() const
+{
+    return buckets_.size();
+}
+
+uint64_t
+Histogram::bucket(size_t i) const
+{
+    return buckets_[i];
+}
+
+uint64_t
+Histogram::bucket_upper_bound(size_t i) const
+{
+    uint64_t const sub = uint64_t(1) << precision_;
+
+    if (i < sub) {
+        return i;
+    }
+
+    int shift = int(i >> precision_) - 1;
+    uint64_t lower = (sub + (i & (sub - 1))) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+size_t
+Histogram::bucket_index(uint64_t value) const
+{
+    uint64_t const sub = uint64_t(1) << precision_;
+
+    if (value < sub) {
+        return size_t(value);
+    }
+
+    int shift = highest_bit(value) - precision_;
+    return size_t(shift + 1) * sub + size_t((value >> shift) - sub);
+}
+
+
+//
+// ATOMIC_HISTOGRAM
+//
+
+Atomic_histogram::Atomic_histogram(int precision)
+        : precision_(precision),
+          size_(Histogram(precision).bucket_count()),
+          buckets_(new std::atomic<uint64_t>[size_]),
+          count_(0),
+          min_(std::numeric_limits<uint64_t>::max()),
+          max_(0),
+          total_(0)
+{
+    for (size_t i = 0; i < size_; ++i) {
+        buckets_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void
+Atomic_histogram::merge(Histogram const& local)
+{
+    if (local.precision_ != precision_) {
+        throw std::invalid_argument(
+                "Atomic_histogram::merge: precision mismatch");
+    }
+
+    if (local.count_ == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < size_; ++i) {
+        if (local.buckets_[i] != 0) {
+            buckets_[i].fetch_add(local.buckets_[i],
+                                  std::memory_order_relaxed);
+        }
+    }
+
+    count_.fetch_add(local.count_, std::memory_order_relaxed);
+    total_.fetch_add(uint64_t(local.total_), std::memory_order_relaxed);
+
+    uint64_t old_min = min_.load(std::memory_order_relaxed);
+    while (local.min_ < old_min &&
+           !min_.compare_exchange_weak(old_min, local.min_,
+                                       std::memory_order_relaxed)) {
+    }
+
+    uint64_t old_max = max_.load(std::memory_order_relaxed);
+    while (local.max_ > old_max &&
+           !max_.compare_exchange_weak(old_max, local.max_,
+                                       std::memory_order_relaxed)) {
+    }
+}
+
+Histogram
+Atomic_histogram::snapshot() const
+{
+    Histogram result(precision_);
+
+    for (size_t i = 0; i < size_; ++i) {
+        result.buckets_[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+
+    result.count_ = count_.load(std::memory_order_relaxed);
+    result.total_ = total_.load(std::memory_order_relaxed);
+    result.min_ = min_.load(std::memory_order_relaxed);
+    result.max_ = max_.load(std::memory_order_relaxed);
+    return result;
+}
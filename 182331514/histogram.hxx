@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+/// A histogram of non-negative integer samples with log-linear buckets (in
+/// the style of HdrHistogram): values are grouped by power of two, and each
+/// power of two is split into 2^precision equal sub-buckets. That keeps the
+/// relative error of any reported value under 2^-precision while using a few
+/// thousand buckets to cover the whole uint64_t range.
+///
+/// Recording is a handful of integer operations and never allocates.
+class Histogram
+{
+public:
+
+    /// Creates an empty histogram. `precision` (1 to 10) is the number of
+    /// bits of each value that are kept exactly.
+    explicit Histogram(int precision = 7);
+
+    /// Adds one sample.
+    void record(uint64_t value);
+
+    /// Adds `count` samples of the same value.
+    void record(uint64_t value, uint64_t count);
+
+    /// Adds all the samples of another histogram with the same precision.
+    void merge(Histogram const& other);
+
+    /// Removes all samples.
+    void clear();
+
+    uint64_t count() const;
+    uint64_t min() const;
+    uint64_t max() const;
+    double mean() const;
+
+    /// The smallest recorded value v such that at least `percent` percent of
+    /// the samples are <= v (up to bucket resolution). Returns 0 if empty.
+    uint64_t percentile(double percent) const;
+
+    /// Writes one line with count, mean, min, p50, p90, p99 and max,
+    /// each divided by `scale` (for example, 1000 to print ns as us).
+    void print_summary(std::ostream& os, double scale = 1.0) const;
+
+    int precision() const;
+
+    //
+    // BUCKET ACCESS (for merging and exporting)
+    //
+
+    size_t bucket_count() const;
+
+    /// The number of samples in bucket i.
+    uint64_t bucket(size_t i) const;
+
+    /// The largest value that lands in bucket i.
+    uint64_t bucket_upper_bound(size_t i) const;
+
+    /// The bucket that `value` lands in.
+    size_t bucket_index(uint64_t value) const;
+
+private:
+
+    friend class Atomic_histogram;
+
+    int precision_;
+    std::vector<uint64_t> buckets_;
+    uint64_t count_;
+    uint64_t min_;
+    uint64_t max_;
+    long double total_;
+};
+
+/// A histogram that many threads can merge into at once without locks.
+/// Each thread records into its own (plain) Histogram and then merges it in
+/// here with atomic adds; nobody ever waits on anybody else.
+class Atomic_histogram
+{
+public:
+
+    explicit Atomic_histogram(int precision = 7);
+
+    /// Adds all the samples of `local`, which must have the same precision.
+    /// Safe to call from several threads at the same time.
+    void merge(Histogram const& local);
+
+    /// A copy of the current contents. Only exact once all merges are done.
+    Histogram snapshot() const;
+
+private:
+
+    int precision_;
+    size_t size_;
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> min_;
+    std::atomic<uint64_t> max_;
+
+    /// Sum of all samples, as an integer so it can be added atomically.
+    std::atomic<uint64_t> total_;
+};
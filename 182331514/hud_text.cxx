@@ -0,0 +1,24 @@
+#include "hud_text.hxx"
+
+Hud_text::Hud_text(ge211::Font const& font, std::string label)
+        : font_(font),
+          label_(std::move(label)),
+          sprite_(),
+          rendered_(false),
+          shown_value_(0)
+{ }
+
+ge211::Text_sprite const&
+Hud_text::show(int value)
+{
+    if (!rendered_ || value != shown_value_) {
+        ge211::Text_sprite::Builder builder(font_);
+        builder << label_ << value;
+        sprite_.reconfigure(builder);
+
+        rendered_ = true;
+        shown_value_ = value;
+    }
+
+    return sprite_;
+}
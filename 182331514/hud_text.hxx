@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ge211.hxx>
+
+#include <string>
+
+/// A line of heads-up-display text ("POINTS: 150", "TIME: 9") that shows a
+/// label followed by a number. The text is only re-rendered when the number
+/// actually changes; on every other frame the cached sprite is reused.
+class Hud_text
+{
+public:
+
+    /// `font` must outlive this object.
+    Hud_text(ge211::Font const& font, std::string label);
+
+    /// Returns the sprite showing `value`, re-rendering it first if it
+    /// currently shows something else.
+    ge211::Text_sprite const& show(int value);
+
+private:
+
+    ge211::Font const& font_;
+    std::string label_;
+    ge211::Text_sprite sprite_;
+
+    /// What sprite_ currently shows, if anything yet.
+    bool rendered_;
+    int shown_value_;
+};
@@ -0,0 +1,238 @@
+#include "input_log.hxx"
+
+#include <cstring>
+#include <stdexcept>
+
+static char const magic[4] = {'W', 'S', 'I', 'L'};
+static uint8_t const format_version = 2;
+
+// Flag bits in the header.
+static uint8_t const anagrams_flag = 1;
+static uint8_t const repeat_free_flag = 2;
+
+// What the space bar adds to the timer.
+static Game_time const space_bonus = 200 * frame_time;
+
+//
+// PRIVATE HELPER FUNCTIONS
+//
+
+// Fixed-width little-endian encoding, so logs are portable between
+// machines.
+
+static void
+put_(std::ostream& out, uint64_t value, int bytes)
+{
+    char buf[8];
+    for (int i = 0; i < bytes; ++i) {
+        buf[i] = char(value >> (8 * i));
+    }
+    out.write(buf, bytes);
+}
+
+static bool
+get_(std::istream& in, uint64_t& value, int bytes)
+{
+    unsigned char buf[8];
+    if (!in.read(reinterpret_cast<char*>(buf), bytes)) {
+        return false;
+    }
+
+    value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= uint64_t(buf[i]) << (8 * i);
+    }
+    return true;
+}
+
+static uint64_t
+double_bits_(double d)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof bits);
+    return bits;
+}
+
+static double
+bits_double_(uint64_t bits)
+{
+    double d;
+    std::memcpy(&d, &bits, sizeof d);
+    return d;
+}
+
+//
+// INPUT EVENTS
+//
+
+Input_event
+Input_event::frame(double dt)
+{
+    return {Kind::frame, dt, {0, 0}, 0};
+}
+
+Input_event
+Input_event::click(Model::Position posn)
+{
+    return {Kind::click, 0.0, posn, 0};
+}
+
+Input_event
+Input_event::key_press(char32_t code)
+{
+    return {Kind::key, 0.0, {0, 0}, code};
+}
+
+void
+apply_key(Model& model, char32_t code)
+{
+    if (code == ' ') {
+        model.add_time_remaining(space_bonus);
+    }
+}
+
+void
+apply_event(Model& model, Input_event const& event)
+{
+    switch (event.kind) {
+    case Input_event::Kind::frame:
+        model.advance(event.dt);
+        break;
+
+    case Input_event::Kind::click:
+        model.click_letter(event.posn);
+        break;
+
+    case Input_event::Kind::key:
+        apply_key(model, event.key);
+        break;
+    }
+}
+
+//
+// INPUT LOGS
+//
+
+Input_log
+Input_log::read(std::string const& filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("could not open input log: " + filename);
+    }
+
+    // (Version 1 logs have no flags byte.)
+    char header[4];
+    uint64_t version, list, flags = 0, seed;
+    if (!in.read(header, 4) ||
+        std::memcmp(header, magic, 4) != 0 ||
+        !get_(in, version, 1) || version < 1 || version > format_version ||
+        !get_(in, list, 1) || list > uint64_t(Word_list::both) ||
+        (version >= 2 && !get_(in, flags, 1)) ||
+        !get_(in, seed, 8))
+    {
+        throw std::runtime_error("not an input log: " + filename);
+    }
+
+    Input_log log;
+    log.seed = seed;
+    log.list = Word_list(list);
+    log.anagrams = (flags & anagrams_flag) != 0;
+    log.repeat_free = (flags & repeat_free_flag) != 0;
+
+    char tag;
+    while (in.get(tag)) {
+        uint64_t a, b;
+
+        switch (Input_event::Kind(tag)) {
+        case Input_event::Kind::frame:
+            if (!get_(in, a, 8)) {
+                return log;
+            }
+            log.events.push_back(Input_event::frame(bits_double_(a)));
+            break;
+
+        case Input_event::Kind::click:
+            if (!get_(in, a, 2) || !get_(in, b, 2)) {
+                return log;
+            }
+            log.events.push_back(Input_event::click(
+                    {int16_t(a), int16_t(b)}));
+            break;
+
+        case Input_event::Kind::key:
+            if (!get_(in, a, 4)) {
+                return log;
+            }
+            log.events.push_back(Input_event::key_press(char32_t(a)));
+            break;
+
+        default:
+            throw std::runtime_error("bad record in input log: " + filename);
+        }
+    }
+
+    return log;
+}
+
+Model
+start_model(Input_log const& log)
+{
+    Model model(embedded_word_bank(log.list), log.seed);
+    if (log.anagrams) {
+        model.set_anagram_index(&embedded_anagram_index(log.list));
+    }
+    if (log.repeat_free) {
+        model.set_repeat_free(true);
+        model.reset(log.seed);
+    }
+    return model;
+}
+
+void
+replay(Input_log const& log, Model& model)
+{
+    for (Input_event const& event : log.events) {
+        apply_event(model, event);
+    }
+}
+
+Input_recorder::Input_recorder(std::string const& filename,
+                               uint64_t seed,
+                               Word_list list,
+                               bool anagrams,
+                               bool repeat_free)
+        : out_(filename, std::ios::binary | std::ios::trunc)
+{
+    if (!out_) {
+        throw std::runtime_error("could not create input log: " + filename);
+    }
+
+    out_.write(magic, 4);
+    put_(out_, format_version, 1);
+    put_(out_, uint64_t(list), 1);
+    put_(out_, (anagrams ? anagrams_flag : 0) |
+               (repeat_free ? repeat_free_flag : 0), 1);
+    put_(out_, seed, 8);
+}
+
+void
+Input_recorder::record(Input_event const& event)
+{
+    out_.put(char(event.kind));
+
+    switch (event.kind) {
+    case Input_event::Kind::frame:
+        put_(out_, double_bits_(event.dt), 8);
+        break;
+
+    case Input_event::Kind::click:
+        put_(out_, uint16_t(event.posn.x), 2);
+        put_(out_, uint16_t(event.posn.y), 2);
+        break;
+
+    case Input_event::Kind::key:
+        put_(out_, event.key, 4);
+        break;
+    }
+}
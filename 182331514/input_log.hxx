@@ -0,0 +1,96 @@
+#pragma once
+
+#include "model.hxx"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+//
+// INPUT EVENTS
+//
+
+/// One thing the player (or the clock) did to the game.
+struct Input_event
+{
+    enum class Kind : uint8_t { frame = 'F', click = 'C', key = 'K' };
+
+    Kind kind;
+
+    /// For frames: the seconds passed to Model::advance().
+    double dt;
+
+    /// For clicks: the board position clicked.
+    Model::Position posn;
+
+    /// For keys: the key's character code.
+    char32_t key;
+
+    static Input_event frame(double dt);
+    static Input_event click(Model::Position posn);
+    static Input_event key_press(char32_t code);
+};
+
+/// What a key press does to the model. Shared by Controller and replay(),
+/// so that a replayed key does exactly what the recorded one did.
+void apply_key(Model& model, char32_t code);
+
+/// Applies one event to `model` the same way Controller does.
+void apply_event(Model& model, Input_event const& event);
+
+//
+// INPUT LOGS
+//
+
+/// Everything needed to play a recorded session again: the word list, seed
+/// and rules the Model started with, and every event in order.
+///
+/// On disk a log is a short header ("WSIL", a format version byte, the
+/// word list byte, a flags byte whose bit 0 means anagrams were accepted
+/// and bit 1 that words were dealt without repeats, and the seed as 8
+/// little-endian bytes) followed by one record per event:
+/// the kind's tag byte, then an 8-byte double for frames, two 2-byte
+/// coordinates for clicks, or a 4-byte code for keys.
+struct Input_log
+{
+    uint64_t seed = Model::default_seed;
+    Word_list list = Word_list::short_list;
+    bool anagrams = false;
+    bool repeat_free = false;
+    std::vector<Input_event> events;
+
+    /// Reads a log written by Input_recorder. Throws std::runtime_error if
+    /// the file can't be opened or isn't a valid log. A log cut off in the
+    /// middle of a record (say, the game crashed) keeps the events before
+    /// it.
+    static Input_log read(std::string const& filename);
+};
+
+/// A fresh Model in the state the logged session started in (accepting
+/// anagrams from embedded_anagram_index(), and dealing words without
+/// repeats, if the session did).
+Model start_model(Input_log const& log);
+
+/// Plays every event of `log` into `model`, as fast as possible.
+void replay(Input_log const& log, Model& model);
+
+/// Appends events to a log file as they happen. Writes are buffered; the
+/// file is flushed when the recorder is destroyed.
+class Input_recorder
+{
+public:
+
+    /// Creates (or truncates) `filename` and writes the header. Throws
+    /// std::runtime_error if the file can't be created.
+    Input_recorder(std::string const& filename,
+                   uint64_t seed,
+                   Word_list list,
+                   bool anagrams = false,
+                   bool repeat_free = false);
+
+    void record(Input_event const& event);
+
+private:
+
+    std::ofstream out_;
+};
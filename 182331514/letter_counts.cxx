@@ -0,0 +1,213 @@
+#include "letter_counts.hxx"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LETTER_COUNTS_X86 1
+#endif
+
+// Set in the last (padding) byte of a word that can't be formed: no tiles
+// ever have any of it.
+static uint8_t const impossible = 0x7F;
+
+//
+// LETTER COUNTS
+//
+
+Letter_counts
+Letter_counts::of(std::string_view letters)
+{
+    Letter_counts result{};
+
+    for (char c : letters) {
+        if (c < 'a' || c > 'z' || result.counts[c - 'a'] == 127) {
+            result.counts[31] = impossible;
+            continue;
+        }
+        ++result.counts[c - 'a'];
+    }
+
+    return result;
+}
+
+Simd_level
+best_simd_level()
+{
+#if defined(LETTER_COUNTS_X86)
+    if (__builtin_cpu_supports("avx2")) {
+        return Simd_level::avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return Simd_level::sse2;
+    }
+#endif
+    return Simd_level::scalar;
+}
+
+//
+// KERNELS
+//
+// Each appends the index of every word none of whose counts is more than
+// the tiles' count of the same letter.
+//
+
+// Eight counts at a time in a uint64_t: with the top bit of each of the
+// tiles' bytes set, subtracting the word's bytes borrows out of a byte (and
+// clears its top bit) only if the word has more of that letter. All counts
+// are under 128, so no borrow crosses into the next byte.
+static void
+formable_scalar_(Letter_counts const* words,
+                 size_t size,
+                 Letter_counts const& tiles,
+                 std::vector<uint32_t>& out)
+{
+    uint64_t const high = 0x8080808080808080ULL;
+
+    uint64_t t[4];
+    std::memcpy(t, tiles.counts, sizeof t);
+    for (uint64_t& lane : t) {
+        lane |= high;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        uint64_t w[4];
+        std::memcpy(w, words[i].counts, sizeof w);
+
+        uint64_t ok = (t[0] - w[0]) & (t[1] - w[1]) &
+                      (t[2] - w[2]) & (t[3] - w[3]);
+        if ((ok & high) == high) {
+            out.push_back(uint32_t(i));
+        }
+    }
+}
+
+#if defined(LETTER_COUNTS_X86)
+
+// max(word, tiles) == tiles in every byte exactly when the tiles suffice.
+
+__attribute__((target("sse2")))
+static void
+formable_sse2_(Letter_counts const* words,
+               size_t size,
+               Letter_counts const& tiles,
+               std::vector<uint32_t>& out)
+{
+    __m128i const t0 = _mm_load_si128(
+            reinterpret_cast<__m128i const*>(tiles.counts));
+    __m128i const t1 = _mm_load_si128(
+            reinterpret_cast<__m128i const*>(tiles.counts + 16));
+
+    for (size_t i = 0; i < size; ++i) {
+        auto w = reinterpret_cast<__m128i const*>(words[i].counts);
+        __m128i e0 = _mm_cmpeq_epi8(_mm_max_epu8(_mm_load_si128(w), t0), t0);
+        __m128i e1 = _mm_cmpeq_epi8(_mm_max_epu8(_mm_load_si128(w + 1), t1),
+                                    t1);
+        if (_mm_movemask_epi8(_mm_and_si128(e0, e1)) == 0xFFFF) {
+            out.push_back(uint32_t(i));
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static void
+formable_avx2_(Letter_counts const* words,
+               size_t size,
+               Letter_counts const& tiles,
+               std::vector<uint32_t>& out)
+{
+    __m256i const t = _mm256_load_si256(
+            reinterpret_cast<__m256i const*>(tiles.counts));
+
+    // Two words per iteration, to keep two loads in flight.
+    size_t i = 0;
+    for (; i + 2 <= size; i += 2) {
+        auto w = reinterpret_cast<__m256i const*>(words[i].counts);
+        uint32_t m0 = uint32_t(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_max_epu8(
+                        _mm256_load_si256(w), t), t)));
+        uint32_t m1 = uint32_t(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_max_epu8(
+                        _mm256_load_si256(w + 1), t), t)));
+        if (m0 == 0xFFFFFFFF) {
+            out.push_back(uint32_t(i));
+        }
+        if (m1 == 0xFFFFFFFF) {
+            out.push_back(uint32_t(i + 1));
+        }
+    }
+
+    for (; i < size; ++i) {
+        auto w = reinterpret_cast<__m256i const*>(words[i].counts);
+        uint32_t m = uint32_t(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_max_epu8(
+                        _mm256_load_si256(w), t), t)));
+        if (m == 0xFFFFFFFF) {
+            out.push_back(uint32_t(i));
+        }
+    }
+}
+
+#endif
+
+//
+// TABLE
+//
+
+Letter_counts_table::Letter_counts_table(Word_bank const& bank)
+        : words_(),
+          level_(best_simd_level())
+{
+    words_.reserve(bank.size());
+    for (std::string_view word : bank) {
+        words_.push_back(Letter_counts::of(word));
+    }
+}
+
+size_t
+Letter_counts_table::size() const
+{
+    return words_.size();
+}
+
+void
+Letter_counts_table::formable(Letter_counts const& tiles,
+                              std::vector<uint32_t>& out) const
+{
+    formable(tiles, out, level_);
+}
+
+void
+Letter_counts_table::formable(Letter_counts const& tiles,
+                              std::vector<uint32_t>& out,
+                              Simd_level level) const
+{
+    // Tiles never count as impossible: a bad character just isn't a tile.
+    Letter_counts usable = tiles;
+    usable.counts[31] = 0;
+
+    switch (level) {
+#if defined(LETTER_COUNTS_X86)
+    case Simd_level::avx2:
+        formable_avx2_(words_.data(), words_.size(), usable, out);
+        return;
+
+    case Simd_level::sse2:
+        formable_sse2_(words_.data(), words_.size(), usable, out);
+        return;
+#endif
+
+    default:
+        formable_scalar_(words_.data(), words_.size(), usable, out);
+        return;
+    }
+}
+
+size_t
+Letter_counts_table::count_formable(Letter_counts const& tiles) const
+{
+    thread_local std::vector<uint32_t> found;
+    found.clear();
+    formable(tiles, found);
+    return found.size();
+}
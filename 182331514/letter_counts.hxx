@@ -0,0 +1,62 @@
+#pragma once
+
+#include "span.hxx"
+#include "word_bank.hxx"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/// How many of each letter a word (or a set of tiles) has: byte i counts
+/// letter 'a' + i. Padded to 32 bytes, so one AVX2 register (or two SSE2
+/// ones) holds a whole histogram.
+struct alignas(32) Letter_counts
+{
+    uint8_t counts[32];
+
+    /// Counts the letters of `letters`. Anything but a-z, or more than 127
+    /// of one letter, marks a word as one no tiles can form; in tiles, such
+    /// characters are just ignored.
+    static Letter_counts of(std::string_view letters);
+};
+
+/// The instruction sets the formable-words kernel can use.
+enum class Simd_level { scalar, sse2, avx2 };
+
+/// The best level this CPU supports.
+Simd_level best_simd_level();
+
+/// The letter counts of every word in a word bank, for answering "which
+/// words can these tiles spell?" (using each tile at most once, and not
+/// necessarily all of them). A query compares the tiles' counts against
+/// every word's, with SIMD where the CPU has it, so it takes a few
+/// microseconds for the 13k words of both lists.
+class Letter_counts_table
+{
+public:
+
+    /// Computes the counts of every word in `bank`.
+    explicit Letter_counts_table(Word_bank const& bank);
+
+    /// Number of words.
+    size_t size() const;
+
+    /// Appends to `out` the index (in the bank) of every word that `tiles`
+    /// can form, in bank order.
+    void formable(Letter_counts const& tiles,
+                  std::vector<uint32_t>& out) const;
+
+    /// The same, using the given level's kernel. The level must be
+    /// supported (see best_simd_level()). For tests and benchmarks.
+    void formable(Letter_counts const& tiles,
+                  std::vector<uint32_t>& out,
+                  Simd_level level) const;
+
+    /// Just the number of words `tiles` can form.
+    size_t count_formable(Letter_counts const& tiles) const;
+
+private:
+
+    std::vector<Letter_counts> words_;
+    Simd_level level_;
+};
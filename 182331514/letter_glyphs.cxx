@@ -0,0 +1,32 @@
+#include "letter_glyphs.hxx"
+
+#include <stdexcept>
+#include <string>
+
+Letter_glyphs::Letter_glyphs(ge211::Font const& font, int cell_size)
+        : sprites_(),
+          offsets_()
+{
+    sprites_.reserve(26);
+    offsets_.reserve(26);
+
+    for (char c = 'A'; c <= 'Z'; ++c) {
+        sprites_.emplace_back(std::string(1, c), font);
+
+        ge211::Dims<int> dims = sprites_.back().dimensions();
+        offsets_.push_back({(cell_size - dims.width) / 2,
+                            (cell_size - dims.height) / 2});
+    }
+}
+
+ge211::Text_sprite const&
+Letter_glyphs::sprite(char letter) const
+{
+    return sprites_.at(size_t(letter - 'a'));
+}
+
+ge211::Posn<int>
+Letter_glyphs::offset(char letter) const
+{
+    return offsets_.at(size_t(letter - 'a'));
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <ge211.hxx>
+
+#include <vector>
+
+/// The letters A to Z, each rendered once, up front, at the size it is
+/// shown, so drawing a letter never scales it (scaling a small rendering up
+/// blurs it, and takes the renderer's slower transformed-copy path). Also
+/// knows where each letter goes to sit centered in a square cell.
+class Letter_glyphs
+{
+public:
+
+    /// Renders every letter with `font`, to be centered in cells
+    /// `cell_size` pixels across.
+    Letter_glyphs(ge211::Font const& font, int cell_size);
+
+    /// The sprite for a letter from 'a' to 'z' (shown in capitals). Throws
+    /// std::out_of_range for any other character.
+    ge211::Text_sprite const& sprite(char letter) const;
+
+    /// Where the letter's sprite goes, relative to its cell's top-left
+    /// corner. Throws std::out_of_range like sprite().
+    ge211::Posn<int> offset(char letter) const;
+
+private:
+
+    std::vector<ge211::Text_sprite> sprites_;
+    std::vector<ge211::Posn<int>> offsets_;
+};
@@ -1,9 +1,30 @@
 #include "controller.hxx"
 
+#include <cstring>
+#include <iostream>
+
+// Usage: word-scramble [--record FILE]
+//
+// With --record, the session is logged to FILE; play it back with the
+// replay tool.
+
 int
-main()
+main(int argc, char* argv[])
 {
-    Controller().run();
+    std::string record_path;
+
+    if (argc == 3 && std::strcmp(argv[1], "--record") == 0) {
+        record_path = argv[2];
+    } else if (argc != 1) {
+        std::cerr << "usage: " << argv[0] << " [--record FILE]\n";
+        return 2;
+    }
+
+    Controller(record_path).run();
+
+    if (profile_enabled) {
+        print_profile(std::cerr);
+    }
 
     return 0;
 }
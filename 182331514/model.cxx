@@ -5,108 +5,209 @@
 //
 
 
-// Wordle Dictionaries pulled from GitHub.
-// Link: https://gist.github.com/scholtes/94f3c0303ba6a7768b47583aff36654d
-static std::string const short_dictionary{"wordle-La.txt"};
-static std::string const long_dictionary{"wordle-Ta.txt"};
-
 //
 /// CONSTRUCTOR
 //
 
 // Default constructor.
 Model::Model()
-        : time_remaining_(),
-          word_bank_(),
+        : Model(Word_list::short_list)
+{}
+
+// Constructor for choosing the short list, the long list, or both. The
+// lists are compiled in, so there is nothing to read (or fail) here.
+Model::Model(Word_list list)
+        : Model(embedded_word_bank(list))
+{}
+
+// Constructor from a dictionary loaded at runtime.
+Model::Model(Dictionary const& dictionary)
+        : Model(Word_bank(dictionary))
+{}
+
+// Constructor from a word bank.
+Model::Model(Word_bank word_bank)
+        : Model(std::move(word_bank), default_seed)
+{}
+
+// Constructor from a word bank and a seed for the random generator.
+Model::Model(Word_bank word_bank, uint64_t seed)
+        : seed_(seed),
+          rng_(seed),
+          time_remaining_(),
+          clock_(),
+          word_bank_(std::move(word_bank)),
           word_index_(),
           word_(),
           word_posns_(),
+          cursor_(0),
+          cell_letter_(),
+          anagrams_(nullptr),
+          selector_(nullptr),
+          repeat_free_(false),
+          schedule_(seed),
+          source_(nullptr),
+          lists_(),
           points_(0),
           hint_(false),
           hint_button_posn_(14, 10),
           is_correct_(true),
           wrong_posn_(0, 0),
           hint_posn_(0,0),
-          change_in_time_(0.0)
+          change_in_time_(),
+          version_(0)
 {
-    // Load in the dictionary.
-    std::ifstream dict_stream = ge211::open_resource_file(short_dictionary);
-
-    // Check if the stream is valid.
-    if (dict_stream.bad()) {
-        throw std::runtime_error("could not read dictionary from: " +
-                                 short_dictionary);
-    }
-
-    // Read each word into a vector.
-    std::string buffer;
-    while (std::getline(dict_stream, buffer)) {
-        word_bank_.push_back(buffer);
-    }
+    cell_letter_.fill(no_cell_letter_);
 
     // Called to initialize member variables above.
     load_new_word_();
 }
 
 // Constructor used for testing.
-Model::Model(std::vector<std::string> dictionary)
-        : time_remaining_(960),
+Model::Model(std::vector<std::string> dictionary, uint64_t seed)
+        : seed_(seed),
+          rng_(seed),
+          time_remaining_(word_time),
+          clock_(),
           word_bank_(dictionary),
-          word_index_(rand() % word_bank_.size()),
+          word_index_(random_index_(word_bank_.size())),
           word_(word_bank_[word_index_]),
-          word_posns_(get_many_rand_posns_(word_)),
+          word_posns_(),
+          cursor_(0),
+          cell_letter_(),
+          anagrams_(nullptr),
+          selector_(nullptr),
+          repeat_free_(false),
+          schedule_(seed),
+          source_(nullptr),
+          lists_(),
           points_(0),
           hint_(false),
           hint_button_posn_(14, 10),
           is_correct_(true),
           wrong_posn_(0, 0),
           hint_posn_(0,0),
-          change_in_time_(0.0)
-{}
+          change_in_time_(),
+          version_(0)
+{
+    cell_letter_.fill(no_cell_letter_);
+
+    // Placed here, since placing letters needs hint_button_posn_.
+    get_many_rand_posns_(word_.size(), word_posns_);
+    index_letters_();
+}
 
 
 //
 // PUBLIC FUNCTIONS
 //
 
+void
+Model::advance(double seconds)
+{
+    pass_time(clock_.tick(seconds));
+}
+
 void
 Model::on_frame(double dt)
 {
-    time_remaining_ -= dt;
+    advance(dt);
+}
+
+int
+Model::pass_time(Game_time elapsed)
+{
+    PROFILE_SCOPE(on_frame);
+
+    if (elapsed <= Game_time::zero()) {
+        return 0;
+    }
+
+    Game_time const total = elapsed;
+
+    // The timer is shown in whole seconds, so only a change there counts
+    // as a visible change.
+    int const seconds_shown = seconds_remaining();
 
-    if (time_remaining_ <= 0 && points_ < 2500) {
+    // Each time the timer reaches 0, a new word starts with a full timer,
+    // and the rest of the time counts against that one.
+    int timed_out = 0;
+    while (points_ < goal_points && elapsed >= time_remaining_) {
+        elapsed -= std::max(time_remaining_, Game_time::zero());
         load_new_word_();
+        ++timed_out;
+    }
+    time_remaining_ -= elapsed;
+
+    if (seconds_remaining() != seconds_shown) {
+        ++version_;
     }
 
     if (!is_correct_) {
         // keeps track of time elapsing for wrong_tile_ so we know when to
         // turn back
-        change_in_time_ += dt;
+        change_in_time_ += total;
         // For wrong tile timer
-        if (change_in_time_ >= 2.0) {
+        if (change_in_time_ >= wrong_flash_time) {
             wrong_posn_ = {0, 0};
-            change_in_time_ = 0.0;
+            change_in_time_ = Game_time::zero();
+            ++version_;
         }
     }
+
+    return timed_out;
+}
+
+void
+Model::reset(uint64_t seed)
+{
+    seed_ = seed;
+    rng_ = Model_rng(seed);
+    schedule_ = Word_schedule(seed);
+    points_ = 0;
+    hint_ = false;
+    is_correct_ = true;
+    wrong_posn_ = {0, 0};
+    hint_posn_ = {0, 0};
+    change_in_time_ = Game_time::zero();
+    clock_.reset();
+
+    // Also bumps version_, and clears the old word's letters.
+    load_new_word_();
 }
 
 void
 Model::click_letter(Position p)
 {
+    PROFILE_SCOPE(click_letter);
+
+    ++version_;
     is_correct_ = true;
     check_hint_(p);
 
-    if (p == word_posns_[0]) {
-        word_posns_.erase(word_posns_.begin());
-        word_.erase(0, 1);
+    // Nothing to click once the game is over.
+    if (letters_left_() == 0) {
+        return;
+    }
+
+    size_t letter = letter_at(p);
+
+    // Starting (or carrying on) a different word from the same tiles.
+    if (letter != cursor_ && letter != no_letter && take_anagram_(letter)) {
+        letter = cursor_;
+    }
+
+    if (letter == cursor_) {
+        cell_letter_[cell_of_(p)] = no_cell_letter_;
+        ++cursor_;
         update_points_(is_correct_);
 
-        if (word_posns_.empty() && points_ < 2500) {
+        if (letters_left_() == 0 && points_ < goal_points) {
             load_new_word_();
         }
     }
 
-    else if (std::count(word_posns_.begin(), word_posns_.end(), p) > 0){
+    else if (letter != no_letter) {
         is_correct_ = false;
         update_points_(is_correct_);
         wrong_posn_ = p;
@@ -118,68 +219,184 @@ Model::click_letter(Position p)
 // PRIVATE HELPER FUNCTIONS
 //
 
-ge211::Posn<int>
-Model::get_rand_posn_()
+size_t
+Model::random_index_(size_t n)
 {
-    // 15 and 11 are the amount of tiles that can fit on the screen (x and y
-    // respectively.
-    return {rand() % 15, rand() % 11};
+    return random_below(rng_, uint32_t(n));
 }
 
-bool
-Model::check_duplicates_(Position p, std::vector<ge211::Posn<int>> v)
+int
+Model::cell_of_(Position p)
+{
+    return p.y * board_width + p.x;
+}
+
+Model::Position
+Model::posn_of_(int cell)
+{
+    return {cell % board_width, cell / board_width};
+}
+
+Board_mask
+Model::blocked_cells_() const
+{
+    Board_mask blocked;
+    blocked.set(cell_of_(hint_button_posn_));
+    return blocked;
+}
+
+void
+Model::get_many_rand_posns_(size_t count, std::vector<Position>& out)
 {
-    // Used tutorial by TechieDelight.
-    // https://www.techiedelight.com/check-vector-contains-given-element-cpp/
+    static_assert(board_width * board_height <= Board_mask::capacity,
+                  "board does not fit in a Board_mask");
+
+    Board_mask const free_cells =
+            Board_mask::first(board_width * board_height) & ~blocked_cells_();
+
+    // List the free cells.
+    uint8_t cells[Board_mask::capacity];
+    int free_count = 0;
+    free_cells.for_each([&](int cell) {
+        cells[free_count++] = uint8_t(cell);
+    });
+
+    if (count > size_t(free_count)) {
+        throw std::length_error("word has more letters than the board has "
+                                "free tiles");
+    }
 
-    // if count (num of times appearing in vector) > 0, return true
-    // else, return false
-    return ((std::count(v.begin(), v.end(), p)) > 0);
+    // Partial Fisher-Yates: after step i, cells[0..i] are a uniformly
+    // random selection of distinct free cells.
+    out.clear();
+    for (size_t i = 0; i < count; ++i) {
+        size_t j = i + random_index_(size_t(free_count) - i);
+        std::swap(cells[i], cells[j]);
+        out.push_back(posn_of_(cells[i]));
+    }
+}
+
+size_t
+Model::letters_left_() const
+{
+    return word_posns_.size() - cursor_;
 }
 
-std::vector<Model::Position>
-Model::get_many_rand_posns_(std::string w)
+bool
+Model::take_anagram_(size_t letter)
 {
-    std::vector<Model::Position> v;
+    if (!anagrams_ || word_.size() != word_posns_.size()) {
+        return false;
+    }
 
-    while (v.size() < w.length()) {
+    std::string_view const solved = std::string_view(word_).substr(0, cursor_);
 
-        Model::Position p = get_rand_posn_();
+    for (std::string_view other : anagrams_->anagrams(word_)) {
+        if (other.substr(0, cursor_) != solved ||
+            other[cursor_] != word_[letter])
+        {
+            continue;
+        }
 
-        if (!check_duplicates_(p, v) && p != hint_button_posn_) {
-            v.push_back(p);
+        // Put the unsolved letters in `other`'s order. Each one is found
+        // among the letters not yet placed, since the words are anagrams.
+        // The first is the tile clicked, even if its letter repeats.
+        for (size_t k = cursor_; k < word_.size(); ++k) {
+            size_t t = k == cursor_ ? letter : k;
+            while (word_[t] != other[k]) {
+                ++t;
+            }
+            std::swap(word_[k], word_[t]);
+            std::swap(word_posns_[k], word_posns_[t]);
         }
+
+        index_letters_();
+        return true;
     }
 
-    return v;
+    return false;
+}
+
+void
+Model::index_letters_()
+{
+    static_assert(board_cells < no_cell_letter_,
+                  "letter indices do not fit in cell_letter_");
+
+    for (size_t i = cursor_; i < word_posns_.size(); ++i) {
+        cell_letter_[cell_of_(word_posns_[i])] = uint8_t(i);
+    }
+}
+
+void
+Model::unindex_letters_()
+{
+    for (size_t i = cursor_; i < word_posns_.size(); ++i) {
+        cell_letter_[cell_of_(word_posns_[i])] = no_cell_letter_;
+    }
 }
 
 void
 Model::load_new_word_()
 {
-    time_remaining_ = 960;
+    ++version_;
+    time_remaining_ = word_time;
+    unindex_letters_();
     word_posns_.clear();
+    cursor_ = 0;
 
-    // Assigns word_index_ a random value from 0 to the size of the dictionary.
-    word_index_ = rand() % word_bank_.size();
+    // Checking for new lists is one atomic load; taking them never waits
+    // either.
+    if (source_ &&
+        (!lists_ || lists_->generation() != source_->generation())) {
+        adopt_lists_();
+    }
+    Word_bank const& bank = word_bank();
+
+    // Assigns word_index_ a random value from 0 to the size of the
+    // dictionary, in constant time whichever way it's picked.
+    if (selector_) {
+        word_index_ = selector_->pick(rng_);
+    } else if (repeat_free_) {
+        word_index_ = schedule_.next(bank.size());
+    } else {
+        word_index_ = random_index_(bank.size());
+    }
 
-    word_ = word_bank_[word_index_];
+    word_ = bank[word_index_];
 
-    for (Position p : get_many_rand_posns_(word_))
-    {
-        word_posns_.push_back(p);
+    get_many_rand_posns_(word_.size(), word_posns_);
+    index_letters_();
+}
+
+void
+Model::adopt_lists_()
+{
+    Word_source::Ref fresh = source_->current();
+
+    if (anagrams_) {
+        anagrams_ = &fresh->anagrams();
+    }
+    if (selector_) {
+        selector_ = fresh->matching_selector(*selector_);
     }
+
+    // The old order was for the old list.
+    schedule_ = Word_schedule(seed_ + fresh->generation());
+
+    // Lets go of the old lists (freed once no Model holds them).
+    lists_ = std::move(fresh);
 }
 
 void
 Model::update_points_(bool is_correct)
 {
-    if (points_ < 2500) { // i.e., if game is still running
-        if (is_correct && word_posns_.empty()) {
+    if (points_ < goal_points) { // i.e., if game is still running
+        if (is_correct && letters_left_() == 0) {
             points_ += 100;
 
             // Just added this condition. It works. See click_letter() L62
-        } else if (is_correct && !word_posns_.empty()) {
+        } else if (is_correct && letters_left_() != 0) {
             points_ += 50;
 
         } else {
@@ -187,8 +404,10 @@ Model::update_points_(bool is_correct)
         }
 
     } else { // i.e., if game is over
+        unindex_letters_();
         word_posns_.clear();
-        word_ = "";
+        word_.clear();
+        cursor_ = 0;
     }
 }
 
@@ -201,9 +420,9 @@ Model::check_hint_(ge211::Posn<int> p){
     }
     // if hint button is clicked, stores hint_posn_ with the position of the
     // next correct letter.
-    if (p == hint_button_posn_){
+    if (p == hint_button_posn_ && letters_left_() > 0){
         hint_ = true;
-        hint_posn_ = word_posns_[0];
+        hint_posn_ = word_posns_[cursor_];
     }
 }
 
@@ -212,22 +431,41 @@ Model::check_hint_(ge211::Posn<int> p){
 // PUBLIC ACCESSOR FUNCTIONS
 //
 
-std::vector<ge211::Posn<int>>
+Span<Model::Position>
 Model::word_posns() const
 {
-    return word_posns_;
+    return full_word_posns().subspan(cursor_);
 }
 
-std::string
+std::string_view
 Model::word() const
+{
+    // (set_word() may have left word_ shorter than word_posns_.)
+    return full_word().substr(std::min(cursor_, word_.size()));
+}
+
+std::string_view
+Model::full_word() const
 {
     return word_;
 }
 
-std::vector<std::string>
+Span<Model::Position>
+Model::full_word_posns() const
+{
+    return word_posns_;
+}
+
+size_t
+Model::letters_solved() const
+{
+    return cursor_;
+}
+
+Word_bank const&
 Model::word_bank() const
 {
-    return word_bank_;
+    return lists_ ? lists_->bank() : word_bank_;
 }
 
 size_t
@@ -254,12 +492,19 @@ Model::hint() const
     return hint_;
 }
 
-int
+Game_time
 Model::time_remaining() const
 {
     return time_remaining_;
 }
 
+int
+Model::seconds_remaining() const
+{
+    return int(std::max(std::chrono::floor<std::chrono::seconds>(
+            time_remaining_).count(), int64_t(0)));
+}
+
 bool
 Model::is_correct() const
 {
@@ -281,7 +526,54 @@ Model::hint_posn() const
 double
 Model::change_in_time() const
 {
-    return change_in_time_;
+    return std::chrono::duration<double>(change_in_time_).count();
+}
+
+double
+Model::time_scale() const
+{
+    return clock_.scale();
+}
+
+size_t
+Model::letter_at(Position p) const
+{
+    if (p.x < 0 || p.x >= board_width || p.y < 0 || p.y >= board_height) {
+        return no_letter;
+    }
+
+    uint8_t const letter = cell_letter_[cell_of_(p)];
+    return letter == no_cell_letter_ ? no_letter : letter;
+}
+
+Model::Tile
+Model::tile_at(Position p) const
+{
+    if (letter_at(p) == no_letter) {
+        return Tile::empty;
+    }
+
+    if (p == wrong_posn_ && !is_correct_) {
+        return Tile::wrong;
+    }
+
+    if (p == hint_posn_ && hint_) {
+        return Tile::hint;
+    }
+
+    return Tile::letter;
+}
+
+uint64_t
+Model::seed() const
+{
+    return seed_;
+}
+
+uint64_t
+Model::version() const
+{
+    return version_;
 }
 
 
@@ -293,52 +585,91 @@ Model::change_in_time() const
 void
 Model::set_word_bank(std::vector<std::string> v)
 {
-    word_bank_.clear();
-
-    for (size_t i = 0; i < v.size(); i++)
-    {
-        word_bank_.push_back(v[i]);
-    }
+    ++version_;
+    word_bank_ = Word_bank(v);
 }
 
 
 void
 Model::set_word(std::string w)
 {
+    ++version_;
+    unindex_letters_();
     word_ = w;
+    cursor_ = 0;
+    index_letters_();
 }
 
 void
 Model::set_word_posns(std::vector<Model::Position> v)
 {
+    ++version_;
+    unindex_letters_();
     word_posns_.clear();
+    cursor_ = 0;
 
     for (size_t i = 0; i < v.size(); i++)
     {
         word_posns_.push_back(v[i]);
     }
+
+    index_letters_();
 }
 
 void
 Model::set_points(int p)
 {
+    ++version_;
     points_ = p;
 }
 
 void
-Model::set_time_remaining(int s)
+Model::set_time_remaining(Game_time t)
 {
-    time_remaining_ = s;
+    ++version_;
+    time_remaining_ = t;
 }
 
 void
 Model::set_is_correct(bool t)
 {
+    ++version_;
     is_correct_ = t;
 }
 
 void
-Model::add_time_remaining(int s)
+Model::set_anagram_index(Anagram_index const* index)
+{
+    anagrams_ = index;
+}
+
+void
+Model::set_word_selector(Word_selector const* selector)
+{
+    selector_ = selector;
+}
+
+void
+Model::set_repeat_free(bool on)
+{
+    repeat_free_ = on;
+}
+
+void
+Model::set_word_source(Word_source const* source)
+{
+    source_ = source;
+}
+
+void
+Model::add_time_remaining(Game_time t)
+{
+    ++version_;
+    time_remaining_ += t;
+}
+
+void
+Model::set_time_scale(double scale)
 {
-    time_remaining_ += s;
+    clock_.set_scale(scale);
 }
\ No newline at end of file
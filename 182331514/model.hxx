@@ -1,7 +1,22 @@
 #pragma once
 
+#include "anagram_index.hxx"
+#include "dictionary.hxx"
+#include "board_mask.hxx"
+#include "embedded_dictionary.hxx"
+#include "game_clock.hxx"
+#include "profile.hxx"
+#include "random.hxx"
+#include "span.hxx"
+#include "word_bank.hxx"
+#include "word_selection.hxx"
+#include "word_source.hxx"
+
 #include <ge211.hxx>
+#include <array>
+#include <cstdint>
 #include <iostream>
+#include <string_view>
 #include <vector>
 #include <algorithm>
 
@@ -13,33 +28,119 @@ public:
     using Dimensions = ge211::Dims<int>;
     using Position = ge211::Posn<int>;
 
+    /// The game is won (and over) once the player has this many points.
+    static constexpr int goal_points = 2500;
+
+    /// Number of tiles that fit on the screen across and down.
+    static constexpr int board_width = 15;
+    static constexpr int board_height = 11;
+    static constexpr int board_cells = board_width * board_height;
+
+    /// How long the player has for each word: 15 seconds, plus one for
+    /// taking in the new word.
+    static constexpr Game_time word_time{std::chrono::seconds(16)};
+
+    /// How long a wrongly clicked tile stays red.
+    static constexpr Game_time wrong_flash_time{std::chrono::seconds(2)};
+
+    /// What letter_at() returns for a cell with no letter still to click.
+    static constexpr size_t no_letter = size_t(-1);
+
+    /// What a board cell shows: nothing, a letter on a plain tile, a letter
+    /// that was just clicked out of order, or the letter the hint points to.
+    enum class Tile { empty, letter, wrong, hint };
+
+    /// Seed used by the constructors that do not take one.
+    static constexpr uint64_t default_seed = 1;
+
     //
     // MODEL CONSTRUCTOR
     //
 
-    /// Default constructor
+    /// Default constructor. Uses the short word list.
     Model();
 
+    /// Constructs a Model whose word bank is the given bundled word list(s),
+    /// as compiled into the program. Needs no resource files.
+    explicit Model(Word_list list);
+
+    /// Constructs a Model whose word bank is copied from a dictionary loaded
+    /// from resource files at runtime.
+    explicit Model(Dictionary const& dictionary);
+
+    /// Constructs a Model with the given word bank.
+    explicit Model(Word_bank word_bank);
+
+    /// Constructs a Model with the given word bank whose random choices
+    /// (words and letter positions) come from its own generator, seeded
+    /// with `seed`. Models never share random state, so they can be used
+    /// from different threads, and two Models with the same word bank and
+    /// seed that receive the same clicks and frames play exactly the same
+    /// game.
+    Model(Word_bank word_bank, uint64_t seed);
+
     /// Constructor used for testing
-    explicit Model(std::vector<std::string> dictionary);
+    explicit Model(std::vector<std::string> dictionary,
+                   uint64_t seed = default_seed);
 
     //
     // PUBLIC ACCESSOR FUNCTIONS
     //
 
-    std::vector<ge211::Posn<int>> word_posns() const;
-    std::string word() const;
-    std::vector<std::string> word_bank() const;
+    /// Read-only views of the positions and letters of the current word that
+    /// are still to be clicked (no copies). word_posns()[0] is always the
+    /// next correct letter. Valid until the next call to a non-const member
+    /// function.
+    Span<Position> word_posns() const;
+    std::string_view word() const;
+
+    /// The whole current word and all of its positions, including the
+    /// letters already clicked, and how many letters have been clicked. So
+    /// the solved prefix is full_word().substr(0, letters_solved()).
+    std::string_view full_word() const;
+    Span<Position> full_word_posns() const;
+    size_t letters_solved() const;
+
+    /// The words being dealt from: the current word source's lists, if
+    /// there is one (see set_word_source()), otherwise the Model's own.
+    Word_bank const& word_bank() const;
     size_t word_index() const;
     int points() const;
     Position hint_button_posn() const;
     bool hint() const;
-    int time_remaining() const;
+
+    /// Time left for the current word, and the same in whole seconds as
+    /// shown (rounded down, and never below 0).
+    Game_time time_remaining() const;
+    int seconds_remaining() const;
+
     bool is_correct() const;
     Position wrong_posn() const;
     Position hint_posn() const;
+
+    /// Seconds the current wrong tile has been red.
     double change_in_time() const;
 
+    /// How fast game time runs compared to real time (see Game_clock).
+    double time_scale() const;
+
+    /// Which letter of full_word() sits at p and is still to be clicked, or
+    /// no_letter if none does (including when p is off the board). Looked up
+    /// in a per-cell table, so it takes constant time.
+    size_t letter_at(Position p) const;
+
+    /// What the tile at p shows. Also constant time (see letter_at()).
+    Tile tile_at(Position p) const;
+
+    /// The seed this model's random generator started from.
+    uint64_t seed() const;
+
+    /// A number that goes up whenever something that View shows changes
+    /// (letters, tiles, points, the displayed seconds, the hint), and stays
+    /// the same otherwise. If it has not changed, the last frame drawn is
+    /// still correct.
+    uint64_t version() const;
+
 
     //
     // PUBLIC MUTATOR FUNCTIONS
@@ -49,20 +150,76 @@ public:
     void set_word(std::string w);
     void set_word_posns(std::vector<Position> v);
     void set_points(int p);
-    void set_time_remaining(int s);
-    void add_time_remaining(int s);
+    void set_time_remaining(Game_time t);
+    void add_time_remaining(Game_time t);
+
+    /// Makes game time run `scale` times as fast as real time in
+    /// advance() and on_frame(); 0 pauses the game. Kept by reset().
+    void set_time_scale(double scale);
     void set_is_correct(bool t);
 
+    /// Lets the player spell any word in `index` that uses exactly the
+    /// current word's letters, not just the word that was picked. For
+    /// example, with the tiles of "least", clicking S first is right, since
+    /// "slate", "stale" and "steal" start with it. Once the player has
+    /// started another word, the unsolved tiles are reordered to spell it,
+    /// so full_word(), word_posns() and the hint follow the player's word.
+    /// `index` must outlive the Model; nullptr (the default) accepts only
+    /// the picked word.
+    void set_anagram_index(Anagram_index const* index);
+
+    /// Picks new words with `selector` (for example, favoring words of one
+    /// difficulty; see word_selection.hxx) instead of uniformly. Takes
+    /// effect from the next word (call reset() to start a game with it).
+    /// `selector` must have been built for this Model's word bank and must
+    /// outlive the Model; nullptr (the default) picks uniformly.
+    void set_word_selector(Word_selector const* selector);
+
+    /// Whether new words are dealt without repeats (see Word_schedule): no
+    /// word comes up twice until every word in the bank has. Off by
+    /// default, which picks each word independently. A selector, if set,
+    /// takes precedence. Takes effect from the next word (call reset() to
+    /// start a game with it); reset() also starts a new order from its
+    /// seed.
+    void set_repeat_free(bool on);
+
+    /// Deals words from `source`'s lists instead of the Model's own word
+    /// bank, moving onto newer lists (say, after the files were edited) at
+    /// the first new word after they're published. The anagram index and
+    /// selector, if set, are swapped for the lists' own, and a new
+    /// repeat-free order starts. Takes effect from the next word (call
+    /// reset() to start a game with it). `source` must outlive the Model.
+    void set_word_source(Word_source const* source);
+
     //
     // PUBLIC GAME FUNCTIONS
     //
 
-    /// Decrements seconds_remaining_ by dt. If seconds_remaining <= 0, call
-    /// load_new_word() to move onto the next word.
+    /// Advances the game by `seconds` of real time (times the time scale),
+    /// as one step of any length. Time is kept in whole ticks with the
+    /// rounding carried over (see Game_clock), so the game runs at the
+    /// right speed at any frame rate, however irregular.
     ///
     /// NOTE: this function will be called in Controller.
+    void advance(double seconds);
+
+    /// The same as advance(dt): one display frame's worth of time.
     void on_frame(double dt);
 
+    /// Lets `elapsed` of game time pass in one step, exactly as if it had
+    /// passed a frame at a time: each word whose time runs out is replaced
+    /// by a new one with a full timer, for as many words as that takes.
+    /// Returns how many words ran out. Lets headless games skip ahead
+    /// without ticking through every frame.
+    int pass_time(Game_time elapsed);
+
+    /// Starts a new game in place, as if this Model had just been built
+    /// from the same word bank with `seed`: same first word and letter
+    /// positions. Keeps the memory it already has, so a Model that has
+    /// been played before can be reset without allocating. version() keeps
+    /// counting up.
+    void reset(uint64_t seed);
+
     /// This is the main game-playing function. It takes in a Position p
     /// (which is the position given by a mouse click) and updates model in
     /// the following ways:
@@ -72,14 +229,22 @@ public:
     ///      (2) Call check_hint(p).
     ///
     ///      (2) If the correct letter was clicked (i.e., p equals
-    ///          word_posns_[0]), remove the first element in word_posns_ and
-    ///          word_ and update points. If the word was just finished (i.e.
-    ///          word_posns_ is empty and points < 2500), load a new word.
+    ///          word_posns()[0]), advance cursor_ past it and update points.
+    ///          Nothing is erased, so this takes constant time. If the word
+    ///          was just finished (i.e. no letters are left and points <
+    ///          2500), load a new word.
     ///
-    ///      (3) Otherwise, compare p to the rest of the positions in
-    ///          word_posns_ (i.e. the wrong letter). For each wp in
-    ///          word_posns_ (starting at index 1, not 0), check if p equals
-    ///          wp. If it does, update points. Stores the wrong position.
+    ///      (3) Otherwise, if p holds one of the other letters still to be
+    ///          clicked, and the letters clicked so far followed by it start
+    ///          a word in the anagram index (see set_anagram_index()),
+    ///          switch to that word and go on as in (2).
+    ///
+    ///      (4) Otherwise, if p holds one of the other letters still to be
+    ///          clicked (i.e. the wrong letter), update points and store
+    ///          the wrong position.
+    ///
+    /// Which letter (if any) is at p is found with letter_at(), so this does
+    /// not depend on the length of the word.
     ///
     /// Otherwise, nothing happens (i.e. p was neither a hint nor a valid
     /// letter on the screen).
@@ -89,20 +254,58 @@ public:
 
 private:
 
+    /// Lets model_bench time the private helpers directly.
+    friend struct Model_bench_access;
+
     //
     // PRIVATE MEMBER VARIABLES
     //
 
-    /// on_frame() runs at 1/60 of a second. If we want each word to have 15
-    /// seconds (plus an extra second for load_new_word()) delay, then
-    /// time_remaining is initialized to 960.
-    int time_remaining_;
+    /// This model's own source of random numbers, and the seed it started
+    /// from. Declared first since the constructors use them to pick the
+    /// first word.
+    uint64_t seed_;
+    Model_rng rng_;
+
+    /// Counts down from word_time for each word (see pass_time()).
+    Game_time time_remaining_;
+
+    /// Turns the real time passed to advance() into game time.
+    Game_clock clock_;
 
     /// All initialized by calling load_new_word() in the Constructor.
-    std::vector<std::string> word_bank_;
+    /// word_ and word_posns_ hold the whole word and are not changed by
+    /// clicks; cursor_ counts how many of its letters have been clicked.
+    Word_bank word_bank_;
     size_t word_index_;
     std::string word_;
     std::vector<Position> word_posns_;
+    size_t cursor_;
+
+    /// For each board cell (see cell_of_()), the index into word_posns_ of
+    /// the letter still to be clicked there, or no_cell_letter_. Kept up to
+    /// date as words load and letters are clicked.
+    static constexpr uint8_t no_cell_letter_ = 0xFF;
+    std::array<uint8_t, board_cells> cell_letter_;
+
+    /// Other words the player may spell, or nullptr. See
+    /// set_anagram_index().
+    Anagram_index const* anagrams_;
+
+    /// How new words are picked, or nullptr for uniformly. See
+    /// set_word_selector().
+    Word_selector const* selector_;
+
+    /// The order words are dealt in when repeat_free_ is set. See
+    /// set_repeat_free().
+    bool repeat_free_;
+    Word_schedule schedule_;
+
+    /// Where the word lists come from, or nullptr to use word_bank_; and
+    /// the lists in use, held alive until the Model moves on. See
+    /// set_word_source().
+    Word_source const* source_;
+    Word_source::Ref lists_;
 
     int points_;
     bool hint_;
@@ -117,28 +320,31 @@ private:
     Position wrong_posn_;
     Position hint_posn_;
 
-    double change_in_time_;
+    Game_time change_in_time_;
+
+    /// See version().
+    uint64_t version_;
 
     //
     // PRIVATE HELPER FUNCTIONS
     //
 
-    /// Uses two random numbers and model dimensions to generate and return a
-    /// random position.
-    ///
-    /// NOTE: this is a helper for get_word_posns().
-    ge211::Posn<int> get_rand_posn_();
+    /// Returns a random number from 0 to n - 1 (n must be positive), using
+    /// this model's generator.
+    size_t random_index_(size_t n);
 
-    /// Compares a given Position p to each Position in a vector of Positions.
-    /// Returns true if p already exists in v. Otherwise, returns false.
-    ///
-    /// NOTE: this is a helper for get_word_posns().
-    bool check_duplicates_(Position p, std::vector<ge211::Posn<int>> v);
+    /// Board cell index of a position (see Board_mask).
+    static int cell_of_(Position p);
 
-    /// Generates a random position for each letter in word_ and puts those
-    /// positions into word_posns_. Uses the helpers get_rand_posn() and
-    /// check_duplicates(). Note that the order of positions in word_posns
-    /// corresponds to the order of the letters in word_. For example:
+    /// Position of a board cell index.
+    static Position posn_of_(int cell);
+
+    /// Cells that letters may never be placed on (the hint button).
+    Board_mask blocked_cells_() const;
+
+    /// Picks `count` distinct random cells for the letters of a word and
+    /// stores their positions in `out`, in letter order, so that
+    /// out[i] is the position of the i-th letter. For example:
     ///
     ///     if word_ = "CAT"
     ///     and word_posns_ = { {1, 3}, {5, 6}, {7, 1} }, then:
@@ -147,18 +353,46 @@ private:
     ///     a_posn = {5, 6}, and
     ///     t_posn = {7, 1}
     ///
+    /// The free cells are found from an occupancy bitboard, then a partial
+    /// Fisher-Yates shuffle draws `count` of them, so this takes the same
+    /// (small) time however long the word is, and never retries. Throws
+    /// std::length_error if the word has more letters than there are free
+    /// cells.
+    ///
     /// NOTE: this is a helper for load_new_word()
-    std::vector<Position> get_many_rand_posns_(std::string w);
+    void get_many_rand_posns_(size_t count, std::vector<Position>& out);
+
+    /// Number of letters of the current word still to be clicked.
+    size_t letters_left_() const;
+
+    /// If the letters solved so far followed by the letter at index
+    /// `letter` start a word in anagrams_ that uses the current word's
+    /// letters, reorders the unsolved letters (and their positions) to
+    /// spell that word and returns true. Otherwise returns false.
+    ///
+    /// NOTE: this is a helper function for click_letter()
+    bool take_anagram_(size_t letter);
+
+    /// Records the letters still to be clicked in cell_letter_, or removes
+    /// them from it. Only touches the cells those letters are on.
+    void index_letters_();
+    void unindex_letters_();
 
     /// Updates model's variables for a new word in word_bank_ by:
-    ///     (1) Resetting time_remaining_ to 960 (16 seconds).
-    ///     (2) Clearing word_posns_.
-    ///     (3) Setting word_ equal to the next word in word_bank_.
+    ///     (1) Resetting time_remaining_ to word_time (16 seconds).
+    ///     (2) Clearing word_posns_ and resetting cursor_.
+    ///     (3) Setting word_ equal to a random word in word_bank_, picked
+    ///         by selector_ if there is one, or dealt by schedule_ if
+    ///         repeat_free_ is set.
     ///     (2) Setting word_posns_ equal to get_many_rand_posns(word_)
     ///
     /// NOTE: this is a helper function for the Constructor and click_letter()
     void load_new_word_();
 
+    /// Moves onto source_'s current lists, with their anagram index and
+    /// selector in place of the old ones.
+    void adopt_lists_();
+
     /// Given whether or not the chosen letter was correct, increments points
     /// by 50 or decrements points by 25. If the word was finished,
     /// increments points by 100 instead of 50. If points are greater
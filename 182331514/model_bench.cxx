@@ -0,0 +1,486 @@
+// Microbenchmarks for the model: loading dictionaries, picking words and
+// letter positions, clicking, and whole headless games. Each benchmark runs
+// its operation in a loop until enough time has passed to measure it, a few
+// times over, and reports the median time and the heap allocations per
+// operation. Everything is seeded, so runs are repeatable.
+//
+// Usage: model_bench [--filter TEXT] [--min-time SECONDS] [--repeat N]
+//                    [--json FILE]
+//
+// With --json, the results are also written to FILE as JSON (or to stdout
+// if FILE is "-"), for comparing releases.
+
+#include "letter_counts.hxx"
+#include "model.hxx"
+#include "simulation.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+//
+// ALLOCATION COUNTING
+//
+
+// Every call to the global operator new in this program is counted, so a
+// benchmark can report how many allocations its operation makes.
+static std::atomic<uint64_t> allocations{0};
+
+void*
+operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+//
+// MODEL ACCESS
+//
+
+// Reaches the private helpers being timed (see the friend in Model).
+struct Model_bench_access
+{
+    static void load_new_word(Model& model)
+    {
+        model.load_new_word_();
+    }
+
+    static void get_many_rand_posns(Model& model,
+                                    size_t count,
+                                    std::vector<Model::Position>& out)
+    {
+        model.get_many_rand_posns_(count, out);
+    }
+};
+
+//
+// BENCHMARK RUNNER
+//
+
+struct Benchmark
+{
+    std::string name;
+
+    // Runs the operation `n` times.
+    std::function<void(long n)> run;
+};
+
+struct Bench_result
+{
+    std::string name;
+    long iterations;
+    double ns_per_op;
+    double min_ns_per_op;
+    double allocs_per_op;
+};
+
+struct Bench_config
+{
+    std::string filter;
+    double min_time = 0.2;
+    int repeat = 5;
+    std::string json_path;
+};
+
+#if !defined(__GNUC__)
+// Where keep_() publishes its result's address when there is no inline asm.
+static void const* volatile kept_;
+#endif
+
+// Keeps the compiler from optimizing away a result.
+template <class T>
+static void
+keep_(T const& value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    kept_ = &value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+static double
+seconds_since_(std::chrono::steady_clock::time_point start)
+{
+    std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Finds an iteration count that takes at least config.min_time, then times
+// config.repeat runs of that many iterations.
+static Bench_result
+measure_(Benchmark const& bench, Bench_config const& config)
+{
+    long n = 1;
+    for (;;) {
+        auto start = std::chrono::steady_clock::now();
+        bench.run(n);
+        double seconds = seconds_since_(start);
+
+        if (seconds >= config.min_time || n >= (1L << 40)) {
+            break;
+        }
+
+        // Aim a little past the target, growing at most 100x per step.
+        double scale = seconds > 0 ? 1.2 * config.min_time / seconds : 100;
+        n = long(double(n) * std::min(100.0, std::max(2.0, scale)));
+    }
+
+    std::vector<double> ns_per_op;
+    uint64_t allocs = 0;
+
+    for (int r = 0; r < config.repeat; ++r) {
+        uint64_t allocs_before = allocations.load();
+        auto start = std::chrono::steady_clock::now();
+        bench.run(n);
+        double seconds = seconds_since_(start);
+        allocs += allocations.load() - allocs_before;
+
+        ns_per_op.push_back(seconds * 1e9 / double(n));
+    }
+
+    std::sort(ns_per_op.begin(), ns_per_op.end());
+
+    return {bench.name,
+            n,
+            ns_per_op[ns_per_op.size() / 2],
+            ns_per_op.front(),
+            double(allocs) / (double(n) * config.repeat)};
+}
+
+static void
+write_json_(std::ostream& os, std::vector<Bench_result> const& results)
+{
+#if defined(WORD_SCRAMBLE_RNG_PCG32)
+    char const* rng = "pcg";
+#else
+    char const* rng = "xoshiro";
+#endif
+
+    os << std::setprecision(10)
+       << "{\n"
+       << "  \"rng\": \"" << rng << "\",\n"
+       << "  \"profile\": " << (profile_enabled ? "true" : "false") << ",\n"
+       << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        Bench_result const& r = results[i];
+        os << (i == 0 ? "\n" : ",\n")
+           << "    {\"name\": \"" << r.name << "\", "
+           << "\"iterations\": " << r.iterations << ", "
+           << "\"ns_per_op\": " << r.ns_per_op << ", "
+           << "\"min_ns_per_op\": " << r.min_ns_per_op << ", "
+           << "\"allocs_per_op\": " << r.allocs_per_op << "}";
+    }
+
+    os << "\n  ]\n}\n";
+}
+
+//
+// BENCHMARKS
+//
+
+static uint64_t const bench_seed = 12345;
+
+// A word of `length` letters, for placing that many tiles.
+static std::string
+word_of_length_(size_t length)
+{
+    return std::string(length, 'a');
+}
+
+static std::vector<Benchmark>
+benchmarks_()
+{
+    std::vector<Benchmark> benches;
+
+    // Loading the dictionaries from the resource files at runtime, and
+    // wrapping the compiled-in ones (for comparison).
+    benches.push_back({"dictionary_load/short", [](long n) {
+        for (long i = 0; i < n; ++i) {
+            Dictionary dictionary(Word_list::short_list);
+            keep_(dictionary.size());
+        }
+    }});
+    benches.push_back({"dictionary_load/long", [](long n) {
+        for (long i = 0; i < n; ++i) {
+            Dictionary dictionary(Word_list::long_list);
+            keep_(dictionary.size());
+        }
+    }});
+    benches.push_back({"embedded_word_bank/both", [](long n) {
+        for (long i = 0; i < n; ++i) {
+            Word_bank bank = embedded_word_bank(Word_list::both);
+            keep_(bank.size());
+        }
+    }});
+
+    benches.push_back({"anagram_index/build", [](long n) {
+        Word_bank bank = embedded_word_bank(Word_list::both);
+        for (long i = 0; i < n; ++i) {
+            Anagram_index index(bank);
+            keep_(index.group_count());
+        }
+    }});
+    benches.push_back({"anagram_index/lookup", [](long n) {
+        Word_bank bank = embedded_word_bank(Word_list::both);
+        Anagram_index const& index = embedded_anagram_index(Word_list::both);
+        for (long i = 0; i < n; ++i) {
+            keep_(index.anagrams(bank[size_t(i) % bank.size()]).size());
+        }
+    }});
+
+    // Which of both lists' words can be formed from 12 tiles, with each
+    // kernel the CPU has.
+    for (Simd_level level : {Simd_level::scalar, Simd_level::sse2,
+                             Simd_level::avx2})
+    {
+        if (level > best_simd_level()) {
+            continue;
+        }
+
+        char const* names[] = {"scalar", "sse2", "avx2"};
+        benches.push_back({std::string("formable_words/") +
+                           names[int(level)], [level](long n) {
+            Letter_counts_table table(embedded_word_bank(Word_list::both));
+            Letter_counts tiles = Letter_counts::of("streamliningx");
+            std::vector<uint32_t> found;
+            found.reserve(table.size());
+            for (long i = 0; i < n; ++i) {
+                found.clear();
+                table.formable(tiles, found, level);
+            }
+            keep_(found.size());
+        }});
+    }
+
+    // Picking a word index: uniformly, and by difficulty with the alias
+    // table.
+    benches.push_back({"pick_word/uniform", [](long n) {
+        Model_rng rng(bench_seed);
+        uint32_t size = uint32_t(embedded_word_bank(Word_list::both).size());
+        size_t sum = 0;
+        for (long i = 0; i < n; ++i) {
+            sum += random_below(rng, size);
+        }
+        keep_(sum);
+    }});
+    benches.push_back({"pick_word/alias", [](long n) {
+        Model_rng rng(bench_seed);
+        Word_selector const& selector =
+                embedded_word_selector(Word_list::both, Difficulty::hard);
+        size_t sum = 0;
+        for (long i = 0; i < n; ++i) {
+            sum += selector.pick(rng);
+        }
+        keep_(sum);
+    }});
+    benches.push_back({"pick_word/schedule", [](long n) {
+        Word_schedule schedule(bench_seed);
+        size_t size = embedded_word_bank(Word_list::both).size();
+        size_t sum = 0;
+        for (long i = 0; i < n; ++i) {
+            sum += schedule.next(size);
+        }
+        keep_(sum);
+    }});
+
+    benches.push_back({"word_source/current", [](long n) {
+        Word_source source(embedded_word_bank(Word_list::short_list));
+        size_t sum = 0;
+        for (long i = 0; i < n; ++i) {
+            sum += source.current()->generation();
+        }
+        keep_(sum);
+    }});
+
+    benches.push_back({"load_new_word", [](long n) {
+        Model model(embedded_word_bank(Word_list::both), bench_seed);
+        for (long i = 0; i < n; ++i) {
+            Model_bench_access::load_new_word(model);
+        }
+        keep_(model.word_index());
+    }});
+
+    for (size_t length : {1, 5, 10, 40, 164}) {
+        benches.push_back({"get_many_rand_posns/" + std::to_string(length),
+                           [length](long n) {
+            Model model(embedded_word_bank(Word_list::short_list),
+                        bench_seed);
+            std::vector<Model::Position> out;
+            out.reserve(length);
+            for (long i = 0; i < n; ++i) {
+                Model_bench_access::get_many_rand_posns(model, length, out);
+            }
+            keep_(out.back());
+        }});
+    }
+
+    // Starting a game: a new Model each time, against resetting one in
+    // place (which is how game_server recycles sessions).
+    benches.push_back({"model/construct", [](long n) {
+        Word_bank bank = embedded_word_bank(Word_list::short_list);
+        for (long i = 0; i < n; ++i) {
+            Model model(bank, bench_seed + uint64_t(i));
+            keep_(model.word_index());
+        }
+    }});
+    benches.push_back({"model/reset", [](long n) {
+        Model model(embedded_word_bank(Word_list::short_list), bench_seed);
+        for (long i = 0; i < n; ++i) {
+            model.reset(bench_seed + uint64_t(i));
+        }
+        keep_(model.word_index());
+    }});
+
+    // Clicking the next letter: every fifth click finishes the word and
+    // loads the next. Points are reset before the game can be won.
+    benches.push_back({"click_letter/correct", [](long n) {
+        Model model(embedded_word_bank(Word_list::short_list), bench_seed);
+        for (long i = 0; i < n; ++i) {
+            if (model.points() > Model::goal_points - 200) {
+                model.set_points(0);
+            }
+            model.click_letter(model.word_posns()[0]);
+        }
+        keep_(model.points());
+    }});
+
+    // Clicking a letter out of order.
+    benches.push_back({"click_letter/wrong", [](long n) {
+        Model model({word_of_length_(8)}, bench_seed);
+        for (long i = 0; i < n; ++i) {
+            if (model.points() < -1000000) {
+                model.set_points(0);
+            }
+            model.click_letter(model.word_posns().back());
+        }
+        keep_(model.points());
+    }});
+
+    // Clicking a tile with no letter on it.
+    benches.push_back({"click_letter/miss", [](long n) {
+        Model model({word_of_length_(8)}, bench_seed);
+        Model::Position empty{0, 0};
+        while (model.letter_at(empty) != Model::no_letter) {
+            ++empty.x;
+        }
+        for (long i = 0; i < n; ++i) {
+            model.click_letter(empty);
+        }
+        keep_(model.points());
+    }});
+
+    // A whole game, played to the goal by a bot that never misses.
+    benches.push_back({"game/perfect", [](long n) {
+        Perfect_bot bot;
+        Simulation_config config;
+        for (long i = 0; i < n; ++i) {
+            Model model(embedded_word_bank(Word_list::short_list),
+                        mix_seed(bench_seed, uint64_t(i)));
+            keep_(play_game(model, bot, config));
+        }
+    }});
+
+    return benches;
+}
+
+//
+// MAIN
+//
+
+static void
+usage_(char const* program)
+{
+    std::cerr << "usage: " << program
+              << " [--filter TEXT] [--min-time SECONDS] [--repeat N]"
+                 " [--json FILE]\n";
+    std::exit(2);
+}
+
+int
+main(int argc, char* argv[])
+{
+    Bench_config config;
+
+    for (int i = 1; i < argc; ++i) {
+        char const* flag = argv[i];
+        if (i + 1 >= argc) {
+            usage_(argv[0]);
+        }
+        char const* value = argv[++i];
+
+        if (std::strcmp(flag, "--filter") == 0) {
+            config.filter = value;
+        } else if (std::strcmp(flag, "--min-time") == 0) {
+            config.min_time = std::atof(value);
+        } else if (std::strcmp(flag, "--repeat") == 0) {
+            config.repeat = std::max(1, std::atoi(value));
+        } else if (std::strcmp(flag, "--json") == 0) {
+            config.json_path = value;
+        } else {
+            usage_(argv[0]);
+        }
+    }
+
+    std::vector<Bench_result> results;
+
+    std::cout << std::left << std::setw(28) << "benchmark"
+              << std::right << std::setw(14) << "ns/op"
+              << std::setw(14) << "allocs/op" << '\n';
+
+    for (Benchmark const& bench : benchmarks_()) {
+        if (bench.name.find(config.filter) == std::string::npos) {
+            continue;
+        }
+
+        results.push_back(measure_(bench, config));
+        Bench_result const& r = results.back();
+
+        std::cout << std::left << std::setw(28) << r.name
+                  << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(14) << r.ns_per_op
+                  << std::setprecision(2) << std::setw(14) << r.allocs_per_op
+                  << std::defaultfloat << std::endl;
+    }
+
+    if (config.json_path == "-") {
+        write_json_(std::cout, results);
+    } else if (!config.json_path.empty()) {
+        std::ofstream out(config.json_path);
+        if (!out) {
+            std::cerr << argv[0] << ": could not write "
+                      << config.json_path << '\n';
+            return 1;
+        }
+        write_json_(out, results);
+    }
+
+    return 0;
+}
@@ -1,5 +1,17 @@
+#include "input_log.hxx"
+#include "letter_counts.hxx"
 #include "model.hxx"
+#include "protocol.hxx"
+#include "simulation.hxx"
 #include <catch.hxx>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
 
 using Dimensions = ge211::Dims<int>;
 using Position = ge211::Posn<int>;
@@ -19,6 +31,26 @@ using Position = ge211::Posn<int>;
  * TEST THREE: TIMER
  * TEST FOUR: HINT FUNCTION
  * TEST FIVE: GAME OVER
+ * TEST SIX: LOADING THE DICTIONARIES
+ * TEST SEVEN: PACKED WORD BANK
+ * TEST EIGHT: EMBEDDED DICTIONARY
+ * TEST NINE: HEADLESS SIMULATION
+ * TEST TEN: BATCH SIMULATION
+ * TEST ELEVEN: SEEDED REPLAY
+ * TEST TWELVE: PLACING LETTERS ON A FULL BOARD
+ * TEST THIRTEEN: SOLVED LETTERS
+ * TEST FOURTEEN: VERSIONS AND TIME AT ANY FRAME RATE
+ * TEST FIFTEEN: LOOKING UP TILES
+ * TEST SIXTEEN: RECORDING AND REPLAYING INPUT
+ * TEST SEVENTEEN: PROFILING PHASES
+ * TEST EIGHTEEN: SERVER PROTOCOL
+ * TEST NINETEEN: RESETTING A GAME IN PLACE
+ * TEST TWENTY: ANAGRAMS
+ * TEST TWENTY-ONE: FORMABLE WORDS
+ * TEST TWENTY-TWO: PICKING WORDS BY DIFFICULTY
+ * TEST TWENTY-THREE: WORDS WITHOUT REPEATS
+ * TEST TWENTY-FOUR: RELOADING THE WORD LISTS
+ * TEST TWENTY-FIVE: THE GAME CLOCK
  */
 
 TEST_CASE("TEST ONE: CLICKING LETTERS")
@@ -148,10 +180,9 @@ TEST_CASE("TEST THREE: TIMER") {
     std::vector<std::string> wb = {"laptop", "sleepy"};
     Model m = Model(wb);
 
-    // Our timer starts at 960. At 60 frames/sec, this is 16 seconds (15
-    // seconds to play the actual word and 1 second to consider the delay of
-    // loading a new word).
-    CHECK( m.time_remaining() == 960 );
+    // Our timer starts at 16 seconds (15 seconds to play the actual word
+    // and 1 second to consider the delay of loading a new word).
+    CHECK( m.time_remaining() == std::chrono::seconds(16) );
 
     // (1) The word is not completed before the timer runs out. If this
     // occurs, a new word is loaded from the word bank, and corresponding
@@ -163,7 +194,7 @@ TEST_CASE("TEST THREE: TIMER") {
     CHECK( m.points() == 0 ); // Points start at 0
 
     m.click_letter( m.word_posns()[0] ); // Let's click one letter.
-    m.on_frame(m.time_remaining()); // Let timer reach 0.
+    m.pass_time(m.time_remaining()); // Let timer reach 0.
 
     // Result: new word is loaded from word bank and the timer is reset.
     // Check that word and its positions have been initialized from the
@@ -176,15 +207,19 @@ TEST_CASE("TEST THREE: TIMER") {
     }
     CHECK( in_bank );
     CHECK( m.word_posns().size() == m.word().length() );
-    CHECK( m.time_remaining() == 960 );
+    CHECK( m.time_remaining() == Model::word_time );
 
     // (2) Complete the word before the timer runs out. If this occurs, a new
     // word is loaded and corresponding variables are reset.
 
-    m.on_frame(60); // Let's let the timer run 1 second.
-    CHECK( m.time_remaining() == 900 ); // Check time was updated.
+    m.on_frame(1.0); // Let's let the timer run 1 second.
+    CHECK( m.time_remaining() == std::chrono::seconds(15) ); // Check time was updated.
 
-    for ( auto pos : m.word_posns() ) {
+    // word_posns() is a view into the model, which clicking changes, so
+    // copy the positions before clicking them.
+    std::vector<Position> to_click(m.word_posns().begin(),
+                                   m.word_posns().end());
+    for ( auto pos : to_click ) {
         m.click_letter(pos); // Click all the correct letters.
     }
 
@@ -200,7 +235,7 @@ TEST_CASE("TEST THREE: TIMER") {
     }
     CHECK( in_bank );
     CHECK( m.word_posns().size() == m.word().length() );
-    CHECK( m.time_remaining() == 960 );
+    CHECK( m.time_remaining() == Model::word_time );
 
     std::cout << "TEST THREE: TIMER PASSED" << std::endl;
 }
@@ -275,6 +310,872 @@ TEST_CASE("TEST FIVE: GAME OVER")
 }
 
 
+TEST_CASE("TEST SIX: LOADING THE DICTIONARIES")
+{
+    /// This test shows that both bundled word lists can be loaded, on their
+    /// own or together, from the first resource directory that has them.
+
+    Dictionary short_words(Word_list::short_list);
+    Dictionary long_words(Word_list::long_list);
+    Dictionary all_words(Word_list::both);
+
+    CHECK( short_words.size() == 2315 );
+    CHECK( long_words.size() == 10657 );
+    CHECK( all_words.size() == short_words.size() + long_words.size() );
+
+    // The short list comes first, then the long list.
+    CHECK( all_words[0] == short_words[0] );
+    CHECK( all_words[short_words.size()] == long_words[0] );
+
+    // Every word is five letters long (no stray newlines).
+    bool all_five = true;
+    for ( auto word : all_words ) {
+        if (word.size() != 5) {
+            all_five = false;
+        }
+    }
+    CHECK( all_five );
+
+    // Mapped or not, a file comes from the same place resource_path() names.
+    std::string const& name = Dictionary::filename(Word_list::short_list);
+    std::ifstream found(Dictionary::resource_path(name), std::ios::binary);
+    std::ostringstream found_text;
+    found_text << found.rdbuf();
+    Mapped_file buffered(name, false);
+    CHECK_FALSE( buffered.is_mapped() );
+    CHECK( buffered.contents() == found_text.str() );
+    CHECK( Mapped_file(name).contents() == found_text.str() );
+    CHECK_THROWS_AS( Dictionary::resource_path("no-such-list.txt"),
+                     std::runtime_error );
+
+    // A Model can be built from either list.
+    Model m = Model(Word_list::long_list);
+    CHECK( m.word_bank().size() == long_words.size() );
+    CHECK( m.word_posns().size() == m.word().length() );
+}
+
+TEST_CASE("TEST SEVEN: PACKED WORD BANK")
+{
+    /// This test shows how words are packed into a Word_bank.
+
+    // Words of one length are stored as fixed-width records, with no
+    // per-word overhead.
+    Word_bank fixed(std::vector<std::string>{"apple", "grape", "lemon"});
+    CHECK( fixed.is_fixed_width() );
+    CHECK( fixed.word_width() == 5 );
+    CHECK( fixed.size() == 3 );
+    CHECK( fixed[1] == "grape" );
+    CHECK( fixed.storage_bytes() == 15 );
+
+    // Words of different lengths still work, using an offset table.
+    Word_bank mixed(std::vector<std::string>{"game", "of", "thrones"});
+    CHECK_FALSE( mixed.is_fixed_width() );
+    CHECK( mixed.size() == 3 );
+    CHECK( mixed[0] == "game" );
+    CHECK( mixed[1] == "of" );
+    CHECK( mixed[2] == "thrones" );
+
+    // Iterating gives the words back in order.
+    std::vector<std::string> copy(mixed.begin(), mixed.end());
+    CHECK( copy == std::vector<std::string>{"game", "of", "thrones"} );
+
+    // The iterators compare and step like any random-access iterator.
+    auto first = mixed.begin(), last = mixed.end();
+    CHECK( (first < last && first <= last && last > first && last >= first) );
+    CHECK( (first <= first && first >= first) );
+    CHECK( *(2 + first) == "thrones" );
+    CHECK( std::lower_bound(first, last, std::string_view("of")) == first + 1 );
+
+    // Both bundled lists together take 5 bytes per word.
+    Word_bank all_words(Dictionary(Word_list::both));
+    CHECK( all_words.is_fixed_width() );
+    CHECK( all_words.storage_bytes() == 5 * all_words.size() );
+}
+
+TEST_CASE("TEST EIGHT: EMBEDDED DICTIONARY")
+{
+    /// This test shows that the word lists compiled into the program match
+    /// the resource files they were generated from.
+
+    Word_bank embedded = embedded_word_bank(Word_list::both);
+    Dictionary loaded(Word_list::both);
+
+    // The embedded list is a view of static storage: no copy was made.
+    CHECK( embedded.is_view() );
+    CHECK( embedded.storage_bytes() == 0 );
+
+    CHECK( embedded.size() == loaded.size() );
+    CHECK( std::equal(embedded.begin(), embedded.end(), loaded.begin()) );
+
+    CHECK( embedded_word_bank(Word_list::short_list).size() == 2315 );
+    CHECK( embedded_word_bank(Word_list::long_list)[0] == "aahed" );
+
+    // The default Model uses the embedded short list.
+    Model m;
+    CHECK( m.word_bank().size() == 2315 );
+    CHECK( m.word_bank().is_view() );
+}
+
+TEST_CASE("TEST NINE: HEADLESS SIMULATION")
+{
+    /// This test plays whole games without a window, using bots.
+
+    Simulation_config config;
+
+    // A perfect bot never misses. A five-letter word is worth 4 * 50 + 100
+    // = 300 points, so it finishes 8 words before reaching the goal. It
+    // clicks every frame, and the winning click ends the game mid-frame.
+    Perfect_bot perfect;
+    Model m1 = Model(Word_list::short_list);
+    Game_result r1 = play_game(m1, perfect, config);
+    CHECK( r1.won );
+    CHECK( r1.points >= Model::goal_points );
+    CHECK( r1.wrong_clicks == 0 );
+    CHECK( r1.words_completed == 2500 / 300 );
+    CHECK( r1.frames == r1.clicks - 1 );
+
+    // The hint-heavy bot spends two clicks per letter.
+    Hint_heavy_bot hinter;
+    Model m2 = Model(Word_list::short_list);
+    Game_result r2 = play_game(m2, hinter, config);
+    CHECK( r2.won );
+    CHECK( r2.clicks == 2 * r1.clicks );
+
+    // The error-prone bot loses points on its mistakes but still wins.
+    Error_prone_bot clumsy(0.2);
+    Model m3 = Model(Word_list::short_list);
+    Game_result r3 = play_game(m3, clumsy, config);
+    CHECK( r3.won );
+    CHECK( r3.wrong_clicks > 0 );
+
+    // A report collects results into histograms.
+    Simulation_report report;
+    report.add(r1);
+    report.add(r3);
+    CHECK( report.games == 2 );
+    CHECK( report.frames.max() == uint64_t(r3.frames) );
+    CHECK( report.frames.percentile(50) == uint64_t(r1.frames) );
+}
+
+TEST_CASE("TEST TEN: BATCH SIMULATION")
+{
+    /// This test shows that spreading games across threads gives the same
+    /// results as playing them on one thread.
+
+    Batch_config config;
+    config.games = 500;
+    config.bot = "error-prone";
+    config.chunk = 7;
+
+    config.threads = 1;
+    Simulation_report one = run_batch(config);
+
+    config.threads = 4;
+    Simulation_report four = run_batch(config);
+
+    CHECK( one.games == 500 );
+    CHECK( four.games == 500 );
+    CHECK( one.games_won == four.games_won );
+    CHECK( one.frames.mean() == four.frames.mean() );
+    CHECK( one.frames.max() == four.frames.max() );
+    CHECK( one.wrong_clicks.mean() == four.wrong_clicks.mean() );
+    CHECK( four.game_ns.count() == 500 );
+
+    // Two Models with the same seed make the same random choices.
+    Model a = Model(embedded_word_bank(Word_list::both), 42);
+    Model b = Model(embedded_word_bank(Word_list::both), 42);
+    CHECK( a.word() == b.word() );
+    CHECK( a.word_posns() == b.word_posns() );
+}
+
+TEST_CASE("TEST ELEVEN: SEEDED REPLAY")
+{
+    /// This test shows that a seed fixes every random choice in a game, so
+    /// replaying the same input gives the same game.
+
+    Word_bank wb = embedded_word_bank(Word_list::both);
+
+    // Play the same game twice, recording each word and its layout.
+    auto play = [&](uint64_t seed) {
+        Model m = Model(wb, seed);
+        Error_prone_bot bot(0.3);
+        bot.reset(seed);
+
+        std::vector<std::string> log;
+        for (int frame = 0; frame < 2000; frame++) {
+            if (auto p = bot.next_click(m)) {
+                m.click_letter(*p);
+            }
+            m.on_frame(1.0 / 60);
+
+            std::string entry(m.word());
+            for (auto pos : m.word_posns()) {
+                entry += " " + std::to_string(pos.x) + "," +
+                         std::to_string(pos.y);
+            }
+            log.push_back(entry);
+        }
+        return log;
+    };
+
+    CHECK( play(7) == play(7) );
+    CHECK( play(7) != play(8) );
+
+    Model m = Model(wb, 7);
+    CHECK( m.seed() == 7 );
+
+    // random_below() stays in range and reaches both ends.
+    Model_rng rng(3);
+    bool saw_low = false, saw_high = false, in_range = true;
+    for (int i = 0; i < 1000; i++) {
+        uint32_t r = random_below(rng, 11);
+        in_range = in_range && r < 11;
+        saw_low = saw_low || r == 0;
+        saw_high = saw_high || r == 10;
+    }
+    CHECK( in_range );
+    CHECK( saw_low );
+    CHECK( saw_high );
+}
+
+TEST_CASE("TEST TWELVE: PLACING LETTERS ON A FULL BOARD")
+{
+    /// This test shows that letters always land on distinct tiles, never on
+    /// the hint button, even when the word fills the whole board.
+
+    // The board has 15 * 11 = 165 tiles, one of which is the hint button.
+    int const free_tiles = Model::board_width * Model::board_height - 1;
+    Model m = Model({std::string(free_tiles, 'a')});
+    CHECK( m.word_posns().size() == size_t(free_tiles) );
+
+    std::vector<bool> used(Model::board_width * Model::board_height, false);
+    bool distinct = true, on_board = true, hint_free = true;
+    for ( auto p : m.word_posns() ) {
+        on_board = on_board && p.x >= 0 && p.x < Model::board_width &&
+                   p.y >= 0 && p.y < Model::board_height;
+        hint_free = hint_free && p != m.hint_button_posn();
+
+        int cell = p.y * Model::board_width + p.x;
+        distinct = distinct && !used[cell];
+        used[cell] = true;
+    }
+    CHECK( distinct );
+    CHECK( on_board );
+    CHECK( hint_free );
+
+    // One letter more than fits is an error rather than an endless loop.
+    CHECK_THROWS_AS( Model({std::string(free_tiles + 1, 'a')}),
+                     std::length_error );
+}
+
+TEST_CASE("TEST THIRTEEN: SOLVED LETTERS")
+{
+    /// This test shows that the whole word stays available while it is
+    /// being clicked, along with how much of it has been solved.
+
+    Model m = Model({"fleabag"});
+    std::vector<Position> wp = { {1, 1}, {2, 2}, {3, 3}, {4, 4},
+                                 {5, 5}, {6, 6}, {7, 7} };
+    m.set_word_posns(wp);
+
+    m.click_letter({1, 1});
+    m.click_letter({2, 2});
+    m.click_letter({9, 9}); // Not a letter: nothing happens.
+    m.click_letter({3, 3});
+
+    // Three letters are solved; the rest are still to be clicked.
+    CHECK( m.letters_solved() == 3 );
+    CHECK( m.full_word().substr(0, m.letters_solved()) == "fle" );
+    CHECK( m.word() == "abag" );
+    CHECK( m.full_word() == "fleabag" );
+    CHECK( m.full_word_posns().size() == 7 );
+    CHECK( m.word_posns()[0] == Position(4, 4) );
+
+    // Clicking a solved letter again is not a mistake.
+    m.click_letter({1, 1});
+    CHECK( m.is_correct() );
+    CHECK( m.points() == 150 );
+
+    // Finishing the word starts the next one from scratch.
+    for ( int i = 4; i <= 7; i++ ) {
+        m.click_letter({i, i});
+    }
+    CHECK( m.letters_solved() == 0 );
+    CHECK( m.word() == "fleabag" );
+}
+
+TEST_CASE("TEST FOURTEEN: VERSIONS AND TIME AT ANY FRAME RATE")
+{
+    /// This test shows that version() only changes when something visible
+    /// changes, and that advance() keeps the timer right however the time
+    /// is split into frames.
+
+    Model m = Model({"fleabag"});
+    uint64_t v = m.version();
+
+    // A word starts at 16 seconds; half a second later it still shows 15.
+    for ( int i = 0; i < 30; i++ ) {
+        m.on_frame(1.0 / 60);
+    }
+    CHECK( m.time_remaining() == std::chrono::milliseconds(15500) );
+    CHECK( m.seconds_remaining() == 15 );
+    CHECK( m.version() == v + 1 );
+
+    v = m.version();
+    for ( int i = 0; i < 29; i++ ) {
+        m.on_frame(1.0 / 60);
+    }
+    CHECK( m.version() == v );
+
+    // Clicking always changes the version.
+    m.click_letter({0, 0});
+    CHECK( m.version() == v + 1 );
+
+    // A quarter second in one step counts the same as 15 frames...
+    Model a = Model({"fleabag"});
+    a.advance(0.25);
+    CHECK( a.time_remaining() == Model::word_time - 15 * frame_time );
+
+    // ...or as uneven steps of any other rate, such as 144 Hz.
+    Model b = Model({"fleabag"});
+    for ( int i = 0; i < 36; i++ ) {
+        b.advance(1.0 / 144);
+    }
+    CHECK( b.time_remaining() == a.time_remaining() );
+}
+
+TEST_CASE("TEST FIFTEEN: LOOKING UP TILES")
+{
+    /// This test shows that letter_at() and tile_at() follow the letters
+    /// as they are placed, clicked and replaced.
+
+    Model m = Model({"cat"});
+    m.set_word_posns({ {1, 1}, {2, 2}, {3, 3} });
+
+    CHECK( m.letter_at({1, 1}) == 0 );
+    CHECK( m.letter_at({3, 3}) == 2 );
+    CHECK( m.letter_at({0, 0}) == Model::no_letter );
+    CHECK( m.letter_at({-1, 20}) == Model::no_letter );
+    CHECK( m.tile_at({2, 2}) == Model::Tile::letter );
+    CHECK( m.tile_at({0, 0}) == Model::Tile::empty );
+
+    // A clicked letter leaves its cell.
+    m.click_letter({1, 1});
+    CHECK( m.letter_at({1, 1}) == Model::no_letter );
+    CHECK( m.tile_at({1, 1}) == Model::Tile::empty );
+
+    // Out of order, it is marked wrong; the hint marks the next letter.
+    m.click_letter({3, 3});
+    CHECK( m.tile_at({3, 3}) == Model::Tile::wrong );
+    m.click_letter(m.hint_button_posn());
+    CHECK( m.tile_at({2, 2}) == Model::Tile::hint );
+
+    // Replacing the positions moves the letters.
+    m.set_word_posns({ {5, 5}, {6, 6}, {7, 7} });
+    CHECK( m.letter_at({2, 2}) == Model::no_letter );
+    CHECK( m.letter_at({6, 6}) == 1 );
+
+    // Finishing the word puts the next one's letters in the table.
+    m.click_letter({5, 5});
+    m.click_letter({6, 6});
+    m.click_letter({7, 7});
+    int indexed = 0;
+    for ( int x = 0; x < Model::board_width; x++ ) {
+        for ( int y = 0; y < Model::board_height; y++ ) {
+            size_t i = m.letter_at({x, y});
+            if ( i != Model::no_letter &&
+                 m.word_posns()[i] == Position(x, y) ) {
+                indexed++;
+            }
+        }
+    }
+    CHECK( indexed == 3 );
+}
+
+TEST_CASE("TEST SIXTEEN: RECORDING AND REPLAYING INPUT")
+{
+    /// This test plays a session while recording it, then shows that
+    /// replaying the log from the file ends in exactly the same state.
+
+    std::string const filename = "model_test_input.log";
+    uint64_t const seed = 42;
+
+    Model played = Model(embedded_word_bank(Word_list::short_list), seed);
+    {
+        Input_recorder recorder(filename, seed, Word_list::short_list);
+        auto play = [&](Input_event const& e) {
+            recorder.record(e);
+            apply_event(played, e);
+        };
+
+        for ( int i = 0; i < 200; i++ ) {
+            play(Input_event::frame(i % 3 == 0 ? 0.02 : 0.015));
+            if ( i % 7 == 0 ) {
+                play(Input_event::click(played.word_posns()[0]));
+            }
+            if ( i % 50 == 0 ) {
+                play(Input_event::click(played.word_posns().back()));
+                play(Input_event::key_press(' '));
+            }
+        }
+        play(Input_event::click({15, 11})); // Off the board.
+    }
+
+    Input_log log = Input_log::read(filename);
+    std::remove(filename.c_str());
+
+    CHECK( log.seed == seed );
+    CHECK( log.list == Word_list::short_list );
+    CHECK( log.events.size() == 200 + 29 + 8 + 1 );
+
+    Model replayed = start_model(log);
+    replay(log, replayed);
+
+    CHECK( replayed.points() == played.points() );
+    CHECK( replayed.time_remaining() == played.time_remaining() );
+    CHECK( replayed.full_word() == played.full_word() );
+    CHECK( replayed.full_word_posns() == played.full_word_posns() );
+    CHECK( replayed.letters_solved() == played.letters_solved() );
+    CHECK( replayed.version() == played.version() );
+
+    CHECK_THROWS_AS( Input_log::read("no_such_input.log"),
+                     std::runtime_error );
+}
+
+TEST_CASE("TEST SEVENTEEN: PROFILING PHASES")
+{
+    /// This test shows that Profile_timer records one sample per scope into
+    /// its phase's histogram, and that the report lists only timed phases.
+
+    clear_profile();
+
+    for ( int i = 0; i < 10; i++ ) {
+        Profile_timer timer(Profile_phase::draw_timer);
+    }
+    CHECK( profile_histogram(Profile_phase::draw_timer).count() == 10 );
+    CHECK( profile_histogram(Profile_phase::draw_points).count() == 0 );
+
+    std::ostringstream report;
+    print_profile(report);
+    CHECK( report.str().find("draw_timer") != std::string::npos );
+    CHECK( report.str().find("draw_points") == std::string::npos );
+
+    // Profiling builds also time the model's own phases.
+    Model m = Model({"cat"});
+    m.on_frame(1.0 / 60);
+    CHECK( profile_histogram(Profile_phase::on_frame).count() ==
+           (profile_enabled ? 1 : 0) );
+
+    clear_profile();
+    CHECK( profile_histogram(Profile_phase::draw_timer).count() == 0 );
+}
+
+TEST_CASE("TEST EIGHTEEN: SERVER PROTOCOL")
+{
+    /// This test shows that messages survive encoding and decoding, that
+    /// partial messages wait for more bytes, and that a client's view kept
+    /// up to date from snapshots and deltas matches the model.
+
+    // Client messages, sent in one go and read back one at a time.
+    std::string bytes;
+    encode_client_message({Client_message::Type::click, {3, -1}}, bytes);
+    encode_client_message({Client_message::Type::key, {0, 0}, ' '}, bytes);
+    encode_client_message({Client_message::Type::new_game, {0, 0}, 0, 99},
+                          bytes);
+    CHECK( bytes.size() == 3 + 5 + 9 );
+
+    Client_message message;
+    CHECK( decode_client_message(bytes.data(), 2, message) == 0 );
+    CHECK( decode_client_message(bytes.data(), bytes.size(), message) == 3 );
+    CHECK( message.posn == Position(3, -1) );
+    CHECK( decode_client_message(bytes.data() + 3, 5, message) == 5 );
+    CHECK( message.key == U' ' );
+    CHECK( decode_client_message(bytes.data() + 8, 9, message) == 9 );
+    CHECK( message.seed == 99 );
+    CHECK( decode_client_message("X", 1, message) == -1 );
+
+    // Server messages.
+    Model m = Model({"fleabag"});
+    Session_view view;
+
+    bytes.clear();
+    encode_snapshot(m, bytes);
+    CHECK( decode_server_message(bytes.data(), bytes.size() - 1, view) == 0 );
+    CHECK( decode_server_message(bytes.data(), bytes.size(), view) ==
+           long(bytes.size()) );
+    CHECK( view.word == "fleabag" );
+    CHECK( Span<Position>(view.word_posns) == m.full_word_posns() );
+    CHECK( view.seconds == 16 );
+
+    m.click_letter(m.word_posns()[0]);
+    m.click_letter(m.word_posns()[1]);
+
+    bytes.clear();
+    encode_delta(m, bytes);
+    CHECK( decode_server_message(bytes.data(), bytes.size(), view) ==
+           long(bytes.size()) );
+    CHECK( view.points == 25 );
+    CHECK( view.letters_solved == 1 );
+    CHECK_FALSE( view.is_correct );
+    CHECK( view.wrong_posn == m.wrong_posn() );
+    CHECK( view.word == "fleabag" );
+}
+
+TEST_CASE("TEST NINETEEN: RESETTING A GAME IN PLACE")
+{
+    /// This test shows that reset() on a finished game gives exactly the
+    /// game a new Model with the same seed would.
+
+    Word_bank bank = embedded_word_bank(Word_list::short_list);
+
+    Model played = Model(bank, 7);
+    Perfect_bot bot;
+    Game_result result = play_game(played, bot, Simulation_config());
+    CHECK( result.won );
+    CHECK( played.points() >= Model::goal_points );
+
+    uint64_t version = played.version();
+    played.reset(99);
+    Model fresh = Model(bank, 99);
+
+    CHECK( played.points() == 0 );
+    CHECK( played.seed() == 99 );
+    CHECK( played.version() > version );
+    CHECK( played.full_word() == fresh.full_word() );
+    CHECK( played.full_word_posns() == fresh.full_word_posns() );
+    CHECK( played.time_remaining() == fresh.time_remaining() );
+    CHECK( played.letter_at(played.word_posns()[0]) == 0 );
+
+    // And it plays on the same way.
+    played.click_letter(played.word_posns()[0]);
+    fresh.click_letter(fresh.word_posns()[0]);
+    CHECK( played.points() == fresh.points() );
+    CHECK( played.full_word_posns() == fresh.full_word_posns() );
+}
+
+TEST_CASE("TEST TWENTY: ANAGRAMS")
+{
+    /// This test shows that the anagram index finds every word a set of
+    /// tiles spells, and that a Model using it accepts any of them.
+
+    Anagram_index const& index = embedded_anagram_index(Word_list::both);
+    Span<std::string_view> words = index.anagrams("tales");
+    std::vector<std::string_view> expected = { "least", "slate", "stale",
+                                               "steal", "leats", "salet",
+                                               "setal", "stela", "taels",
+                                               "tales", "teals", "tesla" };
+    CHECK( std::vector<std::string_view>(words.begin(), words.end()) ==
+           expected );
+    CHECK( index.anagrams("zzzzz").empty() );
+    CHECK( index.size() == embedded_word_bank(Word_list::both).size() );
+    CHECK( Anagram_index::signature("least") ==
+           Anagram_index::signature("steal") );
+    CHECK( Anagram_index::signature("least") !=
+           Anagram_index::signature("leasy") );
+
+    // Tiles of "least"; the player spells "steal" instead.
+    Word_bank bank(std::vector<std::string>{ "least", "steal", "apple" });
+    Anagram_index small(bank);
+    Model m = Model({"least"});
+    m.set_anagram_index(&small);
+    m.set_word_posns({ {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5} });
+
+    m.click_letter({4, 4}); // s
+    CHECK( m.is_correct() );
+    CHECK( m.full_word() == "steal" );
+    CHECK( m.word_posns()[0] == Position(5, 5) ); // t
+    m.click_letter({1, 1}); // l: no word starts "sl" here.
+    CHECK_FALSE( m.is_correct() );
+    for ( Position p : { Position(5, 5), Position(2, 2), Position(3, 3),
+                         Position(1, 1) } ) {
+        m.click_letter(p);
+        CHECK( m.is_correct() );
+    }
+    CHECK( m.points() == 50 * 4 - 25 + 100 );
+
+    // Either of a repeated letter's tiles will do, even with no other
+    // words, since the word is an anagram of itself.
+    m.set_word("apple");
+    m.set_word_posns({ {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5} });
+    m.click_letter({1, 1});
+    m.click_letter({3, 3}); // the second p
+    CHECK( m.is_correct() );
+    CHECK( m.word_posns()[0] == Position(2, 2) );
+}
+
+TEST_CASE("TEST TWENTY-ONE: FORMABLE WORDS")
+{
+    /// This test shows that every kernel finds exactly the words a set of
+    /// tiles can form, by checking them against a plain count comparison.
+
+    Word_bank bank = embedded_word_bank(Word_list::both);
+    Letter_counts_table table(bank);
+    CHECK( table.size() == bank.size() );
+
+    auto can_form = [](std::string_view tiles, std::string_view word) {
+        int counts[26] = {};
+        for ( char c : tiles ) {
+            counts[c - 'a']++;
+        }
+        for ( char c : word ) {
+            if ( --counts[c - 'a'] < 0 ) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    for ( std::string tiles : { "least", "streamlining", "aabbccddeeff",
+                                "qxz", "" } ) {
+        std::vector<uint32_t> expected;
+        for ( size_t i = 0; i < bank.size(); i++ ) {
+            if ( can_form(tiles, bank[i]) ) {
+                expected.push_back(uint32_t(i));
+            }
+        }
+
+        for ( Simd_level level : { Simd_level::scalar, Simd_level::sse2,
+                                   Simd_level::avx2 } ) {
+            if ( level > best_simd_level() ) {
+                continue;
+            }
+            std::vector<uint32_t> found;
+            table.formable(Letter_counts::of(tiles), found, level);
+            CHECK( found == expected );
+        }
+    }
+
+    CHECK( table.count_formable(Letter_counts::of("least")) >= 12 );
+
+    // A word with anything but a-z in it is never formable.
+    Letter_counts_table odd(Word_bank(std::vector<std::string>{ "ab-c" }));
+    CHECK( odd.count_formable(Letter_counts::of("abc-")) == 0 );
+}
+
+TEST_CASE("TEST TWENTY-TWO: PICKING WORDS BY DIFFICULTY")
+{
+    /// This test shows that the alias sampler follows its weights, that
+    /// rare-lettered and uncommon words score as harder, and that a Model
+    /// with a selector gets words of the difficulty asked for.
+
+    std::vector<double> weights = { 1, 0, 3 };
+    Alias_sampler sampler(weights);
+    Model_rng rng(5);
+    int counts[3] = {};
+    for ( int i = 0; i < 40000; i++ ) {
+        counts[sampler.sample(rng)]++;
+    }
+    CHECK( counts[1] == 0 );
+    CHECK( counts[0] > 9000 );
+    CHECK( counts[0] < 11000 );
+
+    Word_bank bank = embedded_word_bank(Word_list::both);
+    std::vector<double> const& scores =
+            embedded_difficulty_scores(Word_list::both);
+    auto score_of = [&](std::string_view word) {
+        for ( size_t i = 0; i < bank.size(); i++ ) {
+            if ( bank[i] == word ) {
+                return scores[i];
+            }
+        }
+        return -1.0;
+    };
+    CHECK( score_of("arise") < score_of("about") );
+    CHECK( score_of("about") < score_of("xylyl") );
+    CHECK( score_of("xylyl") > 0.8 );
+
+    // Average difficulty of 200 words from each tier.
+    auto mean_difficulty = [&](Difficulty tier) {
+        Model m = Model(bank, 11);
+        m.set_word_selector(&embedded_word_selector(Word_list::both, tier));
+        double total = 0;
+        for ( int i = 0; i < 200; i++ ) {
+            m.reset(uint64_t(i));
+            total += scores[m.word_index()];
+        }
+        return total / 200;
+    };
+    CHECK( mean_difficulty(Difficulty::easy) < 0.25 );
+    CHECK( mean_difficulty(Difficulty::medium) > 0.4 );
+    CHECK( mean_difficulty(Difficulty::medium) < 0.6 );
+    CHECK( mean_difficulty(Difficulty::hard) > 0.75 );
+}
+
+TEST_CASE("TEST TWENTY-THREE: WORDS WITHOUT REPEATS")
+{
+    /// This test shows that a Word_schedule deals every index once per pass
+    /// in a different order each pass, and that a Model dealing words that
+    /// way shows every word in its bank before any comes up again.
+
+    for ( uint32_t n : { 1u, 2u, 7u, 64u, 1000u, 12972u } ) {
+        Word_schedule schedule(n);
+        std::vector<size_t> first, second;
+        for ( uint32_t i = 0; i < n; i++ ) {
+            first.push_back(schedule.next(n));
+        }
+        for ( uint32_t i = 0; i < n; i++ ) {
+            second.push_back(schedule.next(n));
+        }
+
+        std::vector<size_t> all(n);
+        for ( uint32_t i = 0; i < n; i++ ) {
+            all[i] = i;
+        }
+        CHECK( std::is_permutation(first.begin(), first.end(),
+                                   all.begin()) );
+        CHECK( std::is_permutation(first.begin(), first.end(),
+                                   second.begin()) );
+        if ( n >= 64 ) {
+            CHECK( first != second );
+        }
+    }
+
+    // Runs out each word's time, recording the words dealt.
+    std::vector<std::string> wb = {"apple", "kitchen", "spoon", "sink",
+                                   "fork", "knife"};
+    Model m = Model(wb, 3);
+    m.set_repeat_free(true);
+    m.reset(3);
+    std::vector<std::string> seen;
+    for ( size_t i = 0; i < wb.size(); i++ ) {
+        seen.push_back(std::string(m.full_word()));
+        m.pass_time(m.time_remaining());
+    }
+    CHECK( std::is_permutation(seen.begin(), seen.end(), wb.begin()) );
+
+    // The same seed deals the same order.
+    Model m2 = Model(wb, 99);
+    m2.set_repeat_free(true);
+    m2.reset(3);
+    CHECK( m2.full_word() == seen[0] );
+}
+
+TEST_CASE("TEST TWENTY-FOUR: RELOADING THE WORD LISTS")
+{
+    /// This test shows that a Model following a Word_source moves onto
+    /// newly published words at its next word, that lists stay alive while
+    /// a Model uses them, and that a source reads its files again when they
+    /// change.
+
+    Word_source source(Word_bank(std::vector<std::string>{"least"}));
+    CHECK( source.generation() == 1 );
+
+    Model m = Model(std::vector<std::string>{"apple"}, 3);
+    m.set_anagram_index(&embedded_anagram_index(Word_list::both));
+    m.set_word_source(&source);
+    m.reset(3);
+    CHECK( m.full_word() == "least" );
+    CHECK( m.word_bank().size() == 1 );
+
+    // The source's index, which has no "slate", replaced the embedded one.
+    m.click_letter(m.full_word_posns()[3]);
+    CHECK_FALSE( m.is_correct() );
+
+    source.publish(Word_bank(std::vector<std::string>{"pilot", "cabin"}), 2);
+    CHECK( source.generation() == 2 );
+    CHECK( m.full_word() == "least" );
+    CHECK( source.retired_count() == 1 );
+
+    // The next word comes from the new lists, and the old ones are freed.
+    m.reset(4);
+    CHECK( m.word_bank().size() == 2 );
+    CHECK( (m.full_word() == "pilot" || m.full_word() == "cabin") );
+    source.collect();
+    CHECK( source.retired_count() == 0 );
+
+    // Publishing while other threads' Models keep taking new words.
+    std::atomic<bool> done(false);
+    std::vector<std::thread> players;
+    for ( int t = 0; t < 4; t++ ) {
+        players.emplace_back([&source, &done, t] {
+            Model player = Model(std::vector<std::string>{"apple"}, 0);
+            player.set_word_source(&source);
+            for ( uint64_t i = 0; !done; i++ ) {
+                player.reset(i * 4 + uint64_t(t));
+            }
+        });
+    }
+    for ( int i = 0; i < 200; i++ ) {
+        source.publish(Word_bank(std::vector<std::string>{
+                i % 2 ? "pilot" : "cabin", "least"}), 1);
+    }
+    done = true;
+    for ( auto& player : players ) {
+        player.join();
+    }
+    CHECK( source.generation() == 202 );
+    source.collect();
+    CHECK( source.retired_count() == 1 );
+
+    // From files, reloading by hand and by watching.
+    std::filesystem::path dir = "model_test_words";
+    std::filesystem::create_directory(dir);
+    auto write_words = [&](std::string const& words) {
+        std::ofstream(dir / "wordle-La.txt") << words;
+    };
+    write_words("apple\nfork\n");
+
+    Word_source files(Word_list::short_list, dir.string());
+    CHECK( files.current()->bank().size() == 2 );
+
+    write_words("apple\nfork\nspoon\n");
+    CHECK( files.reload() );
+    CHECK( files.generation() == 2 );
+    CHECK( files.current()->bank().size() == 3 );
+
+    files.watch();
+    write_words("sink\n");
+    for ( int i = 0; i < 200 && files.generation() == 2; i++ ) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    CHECK( files.generation() == 3 );
+    CHECK( files.current()->bank()[0] == "sink" );
+
+    // A list with no words is ignored.
+    write_words("");
+    CHECK_FALSE( files.reload() );
+    CHECK( files.current()->bank().size() == 1 );
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("TEST TWENTY-FIVE: THE GAME CLOCK")
+{
+    /// This test shows that the time scale speeds up and pauses the game,
+    /// and that passing a lot of time in one step does exactly what passing
+    /// it a frame at a time does, words timing out included.
+
+    Model m = Model({"fleabag"});
+    m.set_time_scale(2);
+    m.advance(1.0);
+    CHECK( m.time_remaining() == std::chrono::seconds(14) );
+
+    m.set_time_scale(0);
+    m.advance(5.0);
+    CHECK( m.time_remaining() == std::chrono::seconds(14) );
+
+    // Time never runs backwards.
+    m.set_time_scale(1);
+    m.advance(-3.0);
+    CHECK( m.time_remaining() == std::chrono::seconds(14) );
+
+    // A minute and a bit, in one step and in 60 Hz frames.
+    std::vector<std::string> wb = {"apple", "kitchen", "spoon", "sink"};
+    Model big = Model(wb, 8), small = Model(wb, 8);
+    Game_time const span = std::chrono::seconds(70);
+
+    CHECK( big.pass_time(span) == 4 );
+    int timed_out = 0;
+    for ( int i = 0; i < 70 * 60; i++ ) {
+        timed_out += small.pass_time(frame_time);
+    }
+    CHECK( timed_out == 4 );
+    CHECK( big.time_remaining() == small.time_remaining() );
+    CHECK( big.time_remaining() == std::chrono::seconds(10) );
+    CHECK( big.full_word() == small.full_word() );
+    CHECK( big.full_word_posns() == small.full_word_posns() );
+}
+
 //
 // TESTING HELPER FUNCTIONS
 //
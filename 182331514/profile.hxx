@@ -0,0 +1,81 @@
+#pragma once
+
+#include "histogram.hxx"
+
+#include <chrono>
+#include <iosfwd>
+
+/// The stages of a frame that can be timed.
+enum class Profile_phase
+{
+    on_frame,
+    click_letter,
+    draw,
+    draw_one_letter,
+    draw_timer,
+    draw_points,
+    draw_hint_button,
+};
+
+/// Number of Profile_phase values.
+static constexpr int profile_phase_count = 7;
+
+/// The phase's name, for reports.
+char const* profile_phase_name(Profile_phase phase);
+
+/// The calling thread's histogram of how long `phase` took, in ns. Each
+/// thread has its own, so timing never needs a lock; the game does all of
+/// its work on one thread, so that thread's histograms tell the whole story.
+Histogram& profile_histogram(Profile_phase phase);
+
+/// Writes one line per phase that has any samples, with its count and
+/// p50/p99/max in microseconds, for the calling thread.
+void print_profile(std::ostream& os);
+
+/// Forgets the calling thread's samples.
+void clear_profile();
+
+/// Times the rest of the enclosing scope into profile_histogram(phase).
+class Profile_timer
+{
+public:
+
+    explicit Profile_timer(Profile_phase phase)
+            : histogram_(profile_histogram(phase)),
+              start_(std::chrono::steady_clock::now())
+    { }
+
+    ~Profile_timer()
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        histogram_.record(uint64_t(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        elapsed).count()));
+    }
+
+    Profile_timer(Profile_timer const&) = delete;
+    Profile_timer& operator=(Profile_timer const&) = delete;
+
+private:
+
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/// PROFILE_SCOPE(phase) times the rest of the enclosing scope as the named
+/// Profile_phase, if the program was built with WORD_SCRAMBLE_PROFILE
+/// defined (the CMake option of the same name). Otherwise it compiles to
+/// nothing, so it costs nothing in normal builds.
+#if defined(WORD_SCRAMBLE_PROFILE)
+#define PROFILE_SCOPE(phase) \
+    Profile_timer profile_timer_(Profile_phase::phase)
+#else
+#define PROFILE_SCOPE(phase) ((void) 0)
+#endif
+
+/// Whether PROFILE_SCOPE() records anything in this build.
+#if defined(WORD_SCRAMBLE_PROFILE)
+static constexpr bool profile_enabled = true;
+#else
+static constexpr bool profile_enabled = false;
+#endif
@@ -0,0 +1,199 @@
+#include "protocol.hxx"
+
+// Sizes of the fixed parts of each message, including the type byte.
+static size_t const click_size = 3;
+static size_t const key_size = 5;
+static size_t const new_game_size = 9;
+static size_t const fields_size = 1 + 4 + 2 + 1 + 1 + 4;
+
+static uint8_t const correct_flag = 1;
+static uint8_t const hint_flag = 2;
+
+//
+// PRIVATE HELPER FUNCTIONS
+//
+
+static void
+put_(std::string& out, uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(char(value >> (8 * i)));
+    }
+}
+
+static uint64_t
+get_(char const* data, int bytes)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= uint64_t(uint8_t(data[i])) << (8 * i);
+    }
+    return value;
+}
+
+static void
+put_fields_(std::string& out, char type, Model const& model)
+{
+    uint8_t flags = 0;
+    if (model.is_correct()) {
+        flags |= correct_flag;
+    }
+    if (model.hint()) {
+        flags |= hint_flag;
+    }
+
+    out.push_back(type);
+    put_(out, uint32_t(model.points()), 4);
+    put_(out, uint16_t(model.seconds_remaining()), 2);
+    put_(out, uint8_t(model.letters_solved()), 1);
+    put_(out, flags, 1);
+    put_(out, uint8_t(model.wrong_posn().x), 1);
+    put_(out, uint8_t(model.wrong_posn().y), 1);
+    put_(out, uint8_t(model.hint_posn().x), 1);
+    put_(out, uint8_t(model.hint_posn().y), 1);
+}
+
+static void
+get_fields_(char const* data, Session_view& view)
+{
+    view.points = int32_t(get_(data + 1, 4));
+    view.seconds = int(get_(data + 5, 2));
+    view.letters_solved = size_t(get_(data + 7, 1));
+
+    uint8_t flags = uint8_t(get_(data + 8, 1));
+    view.is_correct = (flags & correct_flag) != 0;
+    view.hint = (flags & hint_flag) != 0;
+
+    view.wrong_posn = {int(get_(data + 9, 1)), int(get_(data + 10, 1))};
+    view.hint_posn = {int(get_(data + 11, 1)), int(get_(data + 12, 1))};
+}
+
+//
+// CLIENT MESSAGES
+//
+
+void
+encode_client_message(Client_message const& message, std::string& out)
+{
+    out.push_back(char(message.type));
+
+    switch (message.type) {
+    case Client_message::Type::click:
+        put_(out, uint8_t(int8_t(message.posn.x)), 1);
+        put_(out, uint8_t(int8_t(message.posn.y)), 1);
+        break;
+
+    case Client_message::Type::key:
+        put_(out, message.key, 4);
+        break;
+
+    case Client_message::Type::new_game:
+        put_(out, message.seed, 8);
+        break;
+    }
+}
+
+Decode_result
+decode_client_message(char const* data, size_t size, Client_message& message)
+{
+    if (size == 0) {
+        return 0;
+    }
+
+    switch (Client_message::Type(data[0])) {
+    case Client_message::Type::click:
+        if (size < click_size) {
+            return 0;
+        }
+        message.type = Client_message::Type::click;
+        message.posn = {int8_t(data[1]), int8_t(data[2])};
+        return click_size;
+
+    case Client_message::Type::key:
+        if (size < key_size) {
+            return 0;
+        }
+        message.type = Client_message::Type::key;
+        message.key = char32_t(get_(data + 1, 4));
+        return key_size;
+
+    case Client_message::Type::new_game:
+        if (size < new_game_size) {
+            return 0;
+        }
+        message.type = Client_message::Type::new_game;
+        message.seed = get_(data + 1, 8);
+        return new_game_size;
+
+    default:
+        return -1;
+    }
+}
+
+//
+// SERVER MESSAGES
+//
+
+void
+encode_snapshot(Model const& model, std::string& out)
+{
+    put_fields_(out, 'S', model);
+
+    std::string_view word = model.full_word();
+    Span<Model::Position> posns = model.full_word_posns();
+    size_t const n = std::min(word.size(), posns.size());
+
+    put_(out, uint8_t(n), 1);
+    out.append(word.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        put_(out, uint8_t(posns[i].x), 1);
+        put_(out, uint8_t(posns[i].y), 1);
+    }
+}
+
+void
+encode_delta(Model const& model, std::string& out)
+{
+    put_fields_(out, 'D', model);
+}
+
+Decode_result
+decode_server_message(char const* data, size_t size, Session_view& view)
+{
+    if (size < fields_size) {
+        return 0;
+    }
+
+    if (data[0] == 'D') {
+        get_fields_(data, view);
+        return fields_size;
+    }
+
+    if (data[0] != 'S') {
+        return -1;
+    }
+
+    if (size < fields_size + 1) {
+        return 0;
+    }
+
+    size_t const n = uint8_t(data[fields_size]);
+    size_t const total = fields_size + 1 + 3 * n;
+    if (size < total) {
+        return 0;
+    }
+
+    get_fields_(data, view);
+
+    char const* p = data + fields_size + 1;
+    view.word.assign(p, n);
+    p += n;
+
+    view.word_posns.clear();
+    for (size_t i = 0; i < n; ++i) {
+        view.word_posns.push_back({uint8_t(p[0]), uint8_t(p[1])});
+        p += 2;
+    }
+
+    return Decode_result(total);
+}
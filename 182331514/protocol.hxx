@@ -0,0 +1,84 @@
+#pragma once
+
+#include "model.hxx"
+
+#include <string>
+#include <vector>
+
+//
+// GAME SERVER PROTOCOL
+//
+// Every message starts with a one-byte type. Each type has a fixed layout
+// (only a snapshot's size depends on its word), so a receiver can always
+// tell from the bytes it has whether a whole message has arrived. Numbers
+// are little-endian.
+//
+// Client to server:
+//
+//     'C' x:i8 y:i8              click board position (x, y)
+//     'K' code:u32               key press
+//     'N' seed:u64               start a new game (seed 0: server picks)
+//
+// Server to client:
+//
+//     'S' <fields> n:u8 word:n*u8 posns:n*(x:u8 y:u8)
+//                                snapshot: the whole state, sent when a
+//                                session starts and whenever the word
+//                                changes
+//     'D' <fields>               delta: everything but the word, sent when
+//                                anything else the player sees changes
+//
+// where <fields> is
+//
+//     points:i32 seconds:u16 solved:u8 flags:u8
+//     wrong_x:u8 wrong_y:u8 hint_x:u8 hint_y:u8
+//
+// and flags has bit 0 set if the last click was correct and bit 1 set if
+// the hint is showing.
+//
+
+/// A message from a client.
+struct Client_message
+{
+    enum class Type : uint8_t { click = 'C', key = 'K', new_game = 'N' };
+
+    Type type;
+    Model::Position posn{0, 0};
+    char32_t key = 0;
+    uint64_t seed = 0;
+};
+
+/// What a client knows of its game, kept up to date by server messages.
+struct Session_view
+{
+    int points = 0;
+    int seconds = 0;
+    size_t letters_solved = 0;
+    bool is_correct = true;
+    bool hint = false;
+    Model::Position wrong_posn{0, 0};
+    Model::Position hint_posn{0, 0};
+    std::string word;
+    std::vector<Model::Position> word_posns;
+};
+
+/// The result of decoding: how many bytes the message took, 0 if the data
+/// ends before the message does, or -1 if it isn't a valid message.
+using Decode_result = long;
+
+/// Appends the encoding of `message` to `out`.
+void encode_client_message(Client_message const& message, std::string& out);
+
+/// Decodes the message at the front of `data`.
+Decode_result decode_client_message(char const* data,
+                                    size_t size,
+                                    Client_message& message);
+
+/// Appends a snapshot or a delta of `model` to `out`.
+void encode_snapshot(Model const& model, std::string& out);
+void encode_delta(Model const& model, std::string& out);
+
+/// Decodes the server message at the front of `data` into `view`.
+Decode_result decode_server_message(char const* data,
+                                    size_t size,
+                                    Session_view& view);
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+//
+// Small, fast random number engines for the model. Both satisfy the
+// standard UniformRandomBitGenerator requirements (so they also work with
+// <random> distributions), produce 32-bit outputs, and are seeded from a
+// single 64-bit value.
+//
+
+/// Expands a 64-bit seed into well-mixed state words (SplitMix64).
+inline uint64_t
+splitmix64(uint64_t& state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/// xoshiro128++ (Blackman & Vigna): 128 bits of state, period 2^128 - 1.
+class Xoshiro128pp
+{
+public:
+    using result_type = uint32_t;
+
+    explicit Xoshiro128pp(uint64_t seed = 1) { this->seed(seed); }
+
+    void seed(uint64_t seed)
+    {
+        uint64_t a = splitmix64(seed), b = splitmix64(seed);
+        s_[0] = uint32_t(a);
+        s_[1] = uint32_t(a >> 32);
+        s_[2] = uint32_t(b);
+        s_[3] = uint32_t(b >> 32);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max()
+    { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        uint32_t const result = rotl_(s_[0] + s_[3], 7) + s_[0];
+        uint32_t const t = s_[1] << 9;
+
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl_(s_[3], 11);
+
+        return result;
+    }
+
+private:
+    static uint32_t rotl_(uint32_t x, int k)
+    { return (x << k) | (x >> (32 - k)); }
+
+    uint32_t s_[4];
+};
+
+/// PCG32 (O'Neill), the XSH-RR variant: 64 bits of state, period 2^64.
+class Pcg32
+{
+public:
+    using result_type = uint32_t;
+
+    explicit Pcg32(uint64_t seed = 1) { this->seed(seed); }
+
+    void seed(uint64_t seed)
+    {
+        state_ = 0;
+        operator()();
+        state_ += splitmix64(seed);
+        operator()();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max()
+    { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        uint64_t const old = state_;
+        state_ = old * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        uint32_t const xorshifted = uint32_t(((old >> 18) ^ old) >> 27);
+        uint32_t const rot = uint32_t(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+private:
+    uint64_t state_;
+};
+
+/// Returns a uniformly distributed number from 0 to n - 1 (n must be
+/// positive), using Lemire's multiply-and-shift method. Unlike `% n` this
+/// is unbiased and uses the high bits of the engine's output, and it almost
+/// never needs more than one call to the engine.
+template <class RNG>
+uint32_t
+random_below(RNG& rng, uint32_t n)
+{
+    uint64_t m = uint64_t(uint32_t(rng())) * n;
+    uint32_t low = uint32_t(m);
+
+    if (low < n) {
+        uint32_t const threshold = uint32_t(-n) % n;
+        while (low < threshold) {
+            m = uint64_t(uint32_t(rng())) * n;
+            low = uint32_t(m);
+        }
+    }
+
+    return uint32_t(m >> 32);
+}
+
+/// A pseudo-random permutation of 0 to n - 1 chosen by a 64-bit key, that
+/// maps any one index in (expected) constant time and keeps no table, so it
+/// is as cheap to hold for a million values as for ten.
+///
+/// It's a four-round Feistel network over the smallest even number of bits
+/// that covers n, which makes it a bijection on that power of two; indices
+/// it maps past n - 1 are mapped again ("cycle walking") until they land
+/// inside, which keeps it a bijection on 0 to n - 1. The power of two is
+/// less than 4n, so that takes fewer than four rounds on average.
+class Index_permutation
+{
+public:
+
+    /// n must be at least 1 and at most 2^32 - 1.
+    Index_permutation(uint32_t n, uint64_t key)
+            : n_(n),
+              half_bits_(half_bits_for_(n)),
+              key_(key)
+    { }
+
+    uint32_t size() const { return n_; }
+
+    /// Where index i (less than size()) goes.
+    uint32_t operator()(uint32_t i) const
+    {
+        uint64_t x = i;
+        do {
+            x = encrypt_(x);
+        } while (x >= n_);
+        return uint32_t(x);
+    }
+
+private:
+    static int half_bits_for_(uint32_t n)
+    {
+        int bits = 1;
+        while (bits < 32 && (uint64_t(1) << bits) < n) {
+            ++bits;
+        }
+        return (bits + 1) / 2;
+    }
+
+    uint64_t encrypt_(uint64_t x) const
+    {
+        uint64_t const mask = (uint64_t(1) << half_bits_) - 1;
+        uint64_t left = x >> half_bits_, right = x & mask;
+
+        for (uint64_t round = 0; round < 4; ++round) {
+            uint64_t state = key_ ^ (round << 32 | right);
+            uint64_t const next = left ^ (splitmix64(state) & mask);
+            left = right;
+            right = next;
+        }
+
+        return left << half_bits_ | right;
+    }
+
+    uint32_t n_;
+    int half_bits_;
+    uint64_t key_;
+};
+
+/// The engine used by Model, chosen at build time with the WORD_SCRAMBLE_RNG
+/// CMake option (see CMakeLists.txt).
+#if defined(WORD_SCRAMBLE_RNG_PCG32)
+using Model_rng = Pcg32;
+#else
+using Model_rng = Xoshiro128pp;
+#endif
@@ -0,0 +1,119 @@
+// Headless replay of recorded sessions: plays an input log (see
+// input_log.hxx) straight into a Model, with no window and no waiting
+// between frames, as many times as asked. Checks that every replay ends
+// the same way and reports how fast they ran.
+//
+// Usage: replay LOG... [--times N]
+
+#include "histogram.hxx"
+#include "input_log.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static void
+usage_(char const* program)
+{
+    std::cerr << "usage: " << program << " LOG... [--times N]\n";
+    std::exit(2);
+}
+
+// Replays `log` `times` times. Returns false if the replays disagree.
+static bool
+replay_many_(std::string const& filename, long times)
+{
+    Input_log const log = Input_log::read(filename);
+
+    Histogram replay_ns;
+    bool same = true;
+    int points = 0;
+    Game_time time_remaining{};
+    size_t word_index = 0;
+
+    auto batch_start = std::chrono::steady_clock::now();
+
+    for (long i = 0; i < times; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        Model model = start_model(log);
+        replay(log, model);
+        auto stop = std::chrono::steady_clock::now();
+
+        replay_ns.record(uint64_t(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        stop - start).count()));
+
+        if (i == 0) {
+            points = model.points();
+            time_remaining = model.time_remaining();
+            word_index = model.word_index();
+        } else if (model.points() != points ||
+                   model.time_remaining() != time_remaining ||
+                   model.word_index() != word_index)
+        {
+            same = false;
+        }
+    }
+
+    std::chrono::duration<double> seconds =
+            std::chrono::steady_clock::now() - batch_start;
+
+    std::cout << filename << ":\n"
+              << "  seed:            " << log.seed << '\n'
+              << "  events:          " << log.events.size() << '\n'
+              << "  final points:    " << points << '\n'
+              << "  replays:         " << times
+              << (same ? " (all identical)" : " (MISMATCH)") << '\n'
+              << "  events/second:   "
+              << double(log.events.size()) * double(times) /
+                 seconds.count() << '\n'
+              << "  replay time (us): ";
+    replay_ns.print_summary(std::cout, 1000.0);
+    std::cout << '\n';
+
+    return same;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::vector<std::string> logs;
+    long times = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--times") == 0) {
+            if (i + 1 >= argc) {
+                usage_(argv[0]);
+            }
+            times = std::max(1L, std::atol(argv[++i]));
+        } else {
+            logs.push_back(argv[i]);
+        }
+    }
+
+    if (logs.empty()) {
+        usage_(argv[0]);
+    }
+
+    bool ok = true;
+
+    try {
+        for (std::string const& filename : logs) {
+            ok = replay_many_(filename, times) && ok;
+        }
+    } catch (std::exception const& e) {
+        std::cerr << argv[0] << ": " << e.what() << '\n';
+        return 1;
+    }
+
+    if (profile_enabled) {
+        print_profile(std::cout);
+    }
+
+    return ok ? 0 : 1;
+}
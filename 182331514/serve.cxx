@@ -0,0 +1,127 @@
+// Game server: hosts one game per connected client, many clients per
+// process, speaking the binary protocol in protocol.hxx over a local TCP
+// port or Unix socket. Stops cleanly on SIGINT or SIGTERM.
+//
+// Usage: game_server [--port N | --unix PATH] [--list short|long|both]
+//                    [--seed S] [--tick-rate HZ] [--preallocate N]
+//                    [--anagrams] [--no-repeats] [--watch-words]
+//                    [--difficulty easy|medium|hard]
+//
+// With --watch-words the word list is read from Resources/ and reloaded
+// whenever its files change, without dropping anyone's game.
+
+#include "game_server.hxx"
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+static Game_server* running_server = nullptr;
+
+static void
+usage_(char const* program)
+{
+    std::cerr << "usage: " << program
+              << " [--port N | --unix PATH] [--list short|long|both]"
+                 " [--seed S] [--tick-rate HZ] [--preallocate N]"
+                 " [--anagrams] [--no-repeats] [--watch-words]"
+                 " [--difficulty easy|medium|hard]\n";
+    std::exit(2);
+}
+
+static void
+on_signal_(int)
+{
+    if (running_server) {
+        running_server->stop();
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    Server_config config;
+
+    for (int i = 1; i < argc; ++i) {
+        char const* flag = argv[i];
+
+        if (std::strcmp(flag, "--anagrams") == 0) {
+            config.anagrams = true;
+            continue;
+        }
+
+        if (std::strcmp(flag, "--no-repeats") == 0) {
+            config.repeat_free = true;
+            continue;
+        }
+
+        if (std::strcmp(flag, "--watch-words") == 0) {
+            config.watch_words = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            usage_(argv[0]);
+        }
+        char const* value = argv[++i];
+
+        if (std::strcmp(flag, "--port") == 0) {
+            config.port = std::atoi(value);
+        } else if (std::strcmp(flag, "--unix") == 0) {
+            config.unix_path = value;
+        } else if (std::strcmp(flag, "--seed") == 0) {
+            config.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(flag, "--tick-rate") == 0) {
+            config.tick_rate = std::atoi(value);
+        } else if (std::strcmp(flag, "--preallocate") == 0) {
+            config.preallocate = size_t(std::atol(value));
+        } else if (std::strcmp(flag, "--difficulty") == 0) {
+            if (std::strcmp(value, "easy") == 0) {
+                config.difficulty = Difficulty::easy;
+            } else if (std::strcmp(value, "medium") == 0) {
+                config.difficulty = Difficulty::medium;
+            } else if (std::strcmp(value, "hard") == 0) {
+                config.difficulty = Difficulty::hard;
+            } else {
+                usage_(argv[0]);
+            }
+        } else if (std::strcmp(flag, "--list") == 0) {
+            if (std::strcmp(value, "short") == 0) {
+                config.list = Word_list::short_list;
+            } else if (std::strcmp(value, "long") == 0) {
+                config.list = Word_list::long_list;
+            } else if (std::strcmp(value, "both") == 0) {
+                config.list = Word_list::both;
+            } else {
+                usage_(argv[0]);
+            }
+        } else {
+            usage_(argv[0]);
+        }
+    }
+
+    try {
+        Game_server server(config);
+
+        running_server = &server;
+        std::signal(SIGINT, on_signal_);
+        std::signal(SIGTERM, on_signal_);
+
+        std::cerr << "serving on "
+                  << (config.unix_path.empty()
+                      ? "127.0.0.1:" + std::to_string(config.port)
+                      : config.unix_path)
+                  << '\n';
+
+        server.run();
+
+        running_server = nullptr;
+    } catch (std::exception const& e) {
+        std::cerr << argv[0] << ": " << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Headless game runner: plays many games with a bot, spread across all
+// cores, and reports how fast they ran and how they went. No window, no
+// ge211 event loop.
+//
+// Usage: simulate [--games N] [--bot perfect|error-prone|hint-heavy]
+//                 [--error-rate P] [--reaction FRAMES] [--frame-dt S]
+//                 [--list short|long|both] [--seed S] [--threads T]
+//                 [--difficulty easy|medium|hard]
+
+#include "simulation.hxx"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+static void
+usage_(char const* program)
+{
+    std::cerr << "usage: " << program
+              << " [--games N] [--bot perfect|error-prone|hint-heavy]"
+                 " [--error-rate P] [--reaction FRAMES] [--frame-dt S]"
+                 " [--list short|long|both] [--seed S] [--threads T]"
+                 " [--difficulty easy|medium|hard]\n";
+    std::exit(2);
+}
+
+int
+main(int argc, char* argv[])
+{
+    Batch_config config;
+
+    for (int i = 1; i < argc; ++i) {
+        char const* flag = argv[i];
+        if (i + 1 >= argc) {
+            usage_(argv[0]);
+        }
+        char const* value = argv[++i];
+
+        if (std::strcmp(flag, "--games") == 0) {
+            config.games = std::atol(value);
+        } else if (std::strcmp(flag, "--bot") == 0) {
+            config.bot = value;
+        } else if (std::strcmp(flag, "--error-rate") == 0) {
+            config.error_rate = std::atof(value);
+        } else if (std::strcmp(flag, "--reaction") == 0) {
+            config.game.frames_per_click = std::max(1, std::atoi(value));
+        } else if (std::strcmp(flag, "--frame-dt") == 0) {
+            config.game.frame_dt = std::atof(value);
+        } else if (std::strcmp(flag, "--seed") == 0) {
+            config.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(flag, "--threads") == 0) {
+            config.threads = unsigned(std::atoi(value));
+        } else if (std::strcmp(flag, "--difficulty") == 0) {
+            if (std::strcmp(value, "easy") == 0) {
+                config.difficulty = Difficulty::easy;
+            } else if (std::strcmp(value, "medium") == 0) {
+                config.difficulty = Difficulty::medium;
+            } else if (std::strcmp(value, "hard") == 0) {
+                config.difficulty = Difficulty::hard;
+            } else {
+                usage_(argv[0]);
+            }
+        } else if (std::strcmp(flag, "--list") == 0) {
+            if (std::strcmp(value, "short") == 0) {
+                config.list = Word_list::short_list;
+            } else if (std::strcmp(value, "long") == 0) {
+                config.list = Word_list::long_list;
+            } else if (std::strcmp(value, "both") == 0) {
+                config.list = Word_list::both;
+            } else {
+                usage_(argv[0]);
+            }
+        } else {
+            usage_(argv[0]);
+        }
+    }
+
+    if (!make_bot(config.bot)) {
+        usage_(argv[0]);
+    }
+
+    Simulation_report report = run_batch(config);
+
+    std::cout << "bot:             " << config.bot << '\n';
+    report.print(std::cout);
+
+    return 0;
+}
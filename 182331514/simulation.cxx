@@ -0,0 +1,421 @@
+#include "simulation.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+
+//
+// BOTS
+//
+
+void
+Bot::reset(uint64_t)
+{ }
+
+std::optional<Bot::Position>
+Perfect_bot::next_click(Model const& model)
+{
+    if (model.word_posns().empty()) {
+        return std::nullopt;
+    }
+
+    return model.word_posns()[0];
+}
+
+std::string
+Perfect_bot::name() const
+{
+    return "perfect";
+}
+
+Error_prone_bot::Error_prone_bot(double error_rate, unsigned seed)
+        : mistake_(error_rate),
+          rng_(seed)
+{ }
+
+std::optional<Bot::Position>
+Error_prone_bot::next_click(Model const& model)
+{
+    auto posns = model.word_posns();
+
+    if (posns.empty()) {
+        return std::nullopt;
+    }
+
+    // A mistake means clicking any letter other than the next one.
+    if (posns.size() > 1 && mistake_(rng_)) {
+        std::uniform_int_distribution<size_t> pick(1, posns.size() - 1);
+        return posns[pick(rng_)];
+    }
+
+    return posns[0];
+}
+
+void
+Error_prone_bot::reset(uint64_t seed)
+{
+    rng_.seed(seed);
+}
+
+std::string
+Error_prone_bot::name() const
+{
+    return "error-prone";
+}
+
+std::optional<Bot::Position>
+Hint_heavy_bot::next_click(Model const& model)
+{
+    if (model.word_posns().empty()) {
+        return std::nullopt;
+    }
+
+    // Ask for a hint, then take it on the next turn.
+    if (!model.hint()) {
+        return model.hint_button_posn();
+    }
+
+    return model.hint_posn();
+}
+
+std::string
+Hint_heavy_bot::name() const
+{
+    return "hint-heavy";
+}
+
+std::unique_ptr<Bot>
+make_bot(std::string const& name, double error_rate, unsigned seed)
+{
+    if (name == "perfect") {
+        return std::make_unique<Perfect_bot>();
+    } else if (name == "error-prone") {
+        return std::make_unique<Error_prone_bot>(error_rate, seed);
+    } else if (name == "hint-heavy") {
+        return std::make_unique<Hint_heavy_bot>();
+    } else {
+        return nullptr;
+    }
+}
+
+
+//
+// SIMULATION
+//
+
+Game_result
+play_game(Model& model, Bot& bot, Simulation_config const& config)
+{
+    Game_result result;
+
+    Game_time const step = std::chrono::round<Game_time>(
+            std::chrono::duration<double>(config.frame_dt));
+
+    while (result.frames < config.max_frames) {
+        if (result.frames % config.frames_per_click == 0) {
+            if (auto p = bot.next_click(model)) {
+                size_t letters_left = model.word_posns().size();
+                int points_before = model.points();
+
+                model.click_letter(*p);
+                ++result.clicks;
+
+                // Points only move when a letter (rather than the hint
+                // button or an empty tile) was clicked.
+                if (model.points() > points_before) {
+                    ++result.correct_clicks;
+                    if (letters_left == 1) {
+                        ++result.words_completed;
+                    }
+                } else if (model.points() < points_before) {
+                    ++result.wrong_clicks;
+                }
+            }
+        }
+
+        if (model.points() >= Model::goal_points) {
+            result.won = true;
+            break;
+        }
+
+        result.words_timed_out += model.pass_time(step);
+
+        ++result.frames;
+    }
+
+    result.points = model.points();
+    return result;
+}
+
+void
+Simulation_report::add(Game_result const& result)
+{
+    ++games;
+    if (result.won) {
+        ++games_won;
+    }
+
+    // Negative scores are possible for very bad bots; clamp for the
+    // histogram (which only holds non-negative values).
+    frames.record(uint64_t(result.frames));
+    points.record(uint64_t(std::max(result.points, 0)));
+    words_completed.record(uint64_t(result.words_completed));
+    wrong_clicks.record(uint64_t(result.wrong_clicks));
+}
+
+void
+Simulation_report::merge(Simulation_report const& other)
+{
+    games += other.games;
+    games_won += other.games_won;
+    frames.merge(other.frames);
+    points.merge(other.points);
+    words_completed.merge(other.words_completed);
+    wrong_clicks.merge(other.wrong_clicks);
+    game_ns.merge(other.game_ns);
+}
+
+double
+Simulation_report::games_per_second() const
+{
+    return seconds > 0 ? games / seconds : 0.0;
+}
+
+void
+Simulation_report::print(std::ostream& os) const
+{
+    os << "games:           " << games << " (" << games_won << " won)\n"
+       << "elapsed:         " << seconds << " s\n"
+       << "games/sec:       " << games_per_second() << '\n'
+       << "frames/game:     ";
+    frames.print_summary(os);
+    os << "\nfinal points:    ";
+    points.print_summary(os);
+    os << "\nwords/game:      ";
+    words_completed.print_summary(os);
+    os << "\nwrong clicks:    ";
+    wrong_clicks.print_summary(os);
+    if (game_ns.count() > 0) {
+        os << "\nus/game:         ";
+        game_ns.print_summary(os, 1000.0);
+    }
+    os << '\n';
+}
+
+
+//
+// BATCH SIMULATION
+//
+
+namespace {
+
+// One worker's remaining games, [begin, end), packed into a single atomic
+// word so that the owner (taking from the front) and thieves (taking the
+// back half) can each claim work with one compare-and-swap.
+class alignas(64) Work_range
+{
+public:
+
+    void reset(uint32_t begin, uint32_t end)
+    {
+        bits_.store(pack_(begin, end), std::memory_order_release);
+    }
+
+    // Owner: claims up to `chunk` games from the front.
+    bool take(uint32_t chunk, uint32_t& begin, uint32_t& end)
+    {
+        uint64_t old = bits_.load(std::memory_order_acquire);
+
+        for (;;) {
+            uint32_t b = uint32_t(old >> 32), e = uint32_t(old);
+            if (b >= e) {
+                return false;
+            }
+
+            uint32_t nb = e - b > chunk ? b + chunk : e;
+            if (bits_.compare_exchange_weak(old, pack_(nb, e),
+                                            std::memory_order_acq_rel)) {
+                begin = b;
+                end = nb;
+                return true;
+            }
+        }
+    }
+
+    // Thief: claims the back half, if there are at least two games left.
+    bool steal_half(uint32_t& begin, uint32_t& end)
+    {
+        uint64_t old = bits_.load(std::memory_order_acquire);
+
+        for (;;) {
+            uint32_t b = uint32_t(old >> 32), e = uint32_t(old);
+            if (b >= e || e - b < 2) {
+                return false;
+            }
+
+            uint32_t mid = b + (e - b) / 2;
+            if (bits_.compare_exchange_weak(old, pack_(b, mid),
+                                            std::memory_order_acq_rel)) {
+                begin = mid;
+                end = e;
+                return true;
+            }
+        }
+    }
+
+private:
+
+    static uint64_t pack_(uint32_t begin, uint32_t end)
+    {
+        return uint64_t(begin) << 32 | end;
+    }
+
+    std::atomic<uint64_t> bits_{0};
+};
+
+// The totals that all workers merge into, without locks.
+struct Shared_report
+{
+    std::atomic<long> games{0};
+    std::atomic<long> games_won{0};
+    Atomic_histogram frames{};
+    Atomic_histogram points{10};
+    Atomic_histogram words_completed{};
+    Atomic_histogram wrong_clicks{};
+    Atomic_histogram game_ns{};
+
+    void merge(Simulation_report const& local)
+    {
+        games.fetch_add(local.games, std::memory_order_relaxed);
+        games_won.fetch_add(local.games_won, std::memory_order_relaxed);
+        frames.merge(local.frames);
+        points.merge(local.points);
+        words_completed.merge(local.words_completed);
+        wrong_clicks.merge(local.wrong_clicks);
+        game_ns.merge(local.game_ns);
+    }
+
+    Simulation_report snapshot() const
+    {
+        Simulation_report result;
+        result.games = games.load();
+        result.games_won = games_won.load();
+        result.frames = frames.snapshot();
+        result.points = points.snapshot();
+        result.words_completed = words_completed.snapshot();
+        result.wrong_clicks = wrong_clicks.snapshot();
+        result.game_ns = game_ns.snapshot();
+        return result;
+    }
+};
+
+} // end anonymous namespace
+
+uint64_t
+mix_seed(uint64_t seed, uint64_t index)
+{
+    uint64_t state = seed + index * 0x9E3779B97F4A7C15ULL;
+    return splitmix64(state);
+}
+
+Simulation_report
+run_batch(Batch_config const& config)
+{
+    using clock = std::chrono::steady_clock;
+
+    if (!make_bot(config.bot)) {
+        throw std::invalid_argument("run_batch: unknown bot: " + config.bot);
+    }
+
+    // Widened before comparing: on LLP64 long(UINT32_MAX) would be -1.
+    if (config.games < 0 || uint64_t(config.games) > UINT32_MAX) {
+        throw std::invalid_argument("run_batch: bad number of games");
+    }
+
+    unsigned threads = config.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    uint32_t const games = uint32_t(config.games);
+    uint32_t const chunk = uint32_t(std::max(1L, config.chunk));
+    Word_bank const words = embedded_word_bank(config.list);
+    Word_selector const* const selector =
+            config.difficulty
+            ? &embedded_word_selector(config.list, *config.difficulty)
+            : nullptr;
+
+    // Deal the games out evenly to start with.
+    std::vector<Work_range> ranges(threads);
+    for (unsigned w = 0; w < threads; ++w) {
+        ranges[w].reset(uint32_t(uint64_t(games) * w / threads),
+                        uint32_t(uint64_t(games) * (w + 1) / threads));
+    }
+
+    Shared_report shared;
+
+    auto work = [&](unsigned me) {
+        std::unique_ptr<Bot> bot = make_bot(config.bot, config.error_rate);
+        Simulation_report local;
+        uint32_t begin, end;
+
+        for (;;) {
+            if (!ranges[me].take(chunk, begin, end)) {
+                // Out of work: steal half of someone else's.
+                bool stole = false;
+                for (unsigned k = 1; k < threads && !stole; ++k) {
+                    unsigned victim = (me + k) % threads;
+                    if (ranges[victim].steal_half(begin, end)) {
+                        ranges[me].reset(begin, end);
+                        stole = true;
+                    }
+                }
+
+                if (!stole) {
+                    break;
+                }
+
+                continue;
+            }
+
+            for (uint32_t i = begin; i < end; ++i) {
+                uint64_t seed = mix_seed(config.seed, i);
+                auto start = clock::now();
+
+                Model model(words, seed);
+                if (selector) {
+                    model.set_word_selector(selector);
+                    model.reset(seed);
+                }
+                bot->reset(seed);
+                Game_result result = play_game(model, *bot, config.game);
+
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        clock::now() - start).count();
+                local.add(result);
+                local.game_ns.record(uint64_t(ns));
+            }
+        }
+
+        shared.merge(local);
+    };
+
+    auto start = clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned w = 1; w < threads; ++w) {
+        workers.emplace_back(work, w);
+    }
+    work(0);
+    for (std::thread& t : workers) {
+        t.join();
+    }
+
+    Simulation_report report = shared.snapshot();
+    report.seconds = std::chrono::duration<double>(clock::now() - start)
+            .count();
+    return report;
+}
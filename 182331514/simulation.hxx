@@ -0,0 +1,178 @@
+#pragma once
+
+#include "histogram.hxx"
+#include "model.hxx"
+
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+
+//
+// BOTS
+//
+
+/// A simulated player. Each frame on which the bot may act, the simulation
+/// asks it where to click.
+class Bot
+{
+public:
+
+    using Position = Model::Position;
+
+    virtual ~Bot() = default;
+
+    /// The board position to click, or nothing to wait this turn.
+    virtual std::optional<Position> next_click(Model const& model) = 0;
+
+    /// Called before each game. Bots that make random choices reseed
+    /// themselves, so that a game depends only on its seed.
+    virtual void reset(uint64_t seed);
+
+    /// A short name for reports.
+    virtual std::string name() const = 0;
+};
+
+/// Always clicks the next correct letter.
+class Perfect_bot : public Bot
+{
+public:
+    std::optional<Position> next_click(Model const& model) override;
+    std::string name() const override;
+};
+
+/// Clicks the next correct letter, except that with probability
+/// `error_rate` it clicks one of the other letters instead.
+class Error_prone_bot : public Bot
+{
+public:
+    explicit Error_prone_bot(double error_rate, unsigned seed = 1);
+
+    std::optional<Position> next_click(Model const& model) override;
+    void reset(uint64_t seed) override;
+    std::string name() const override;
+
+private:
+    std::bernoulli_distribution mistake_;
+    Model_rng rng_;
+};
+
+/// Asks for a hint before every letter, then clicks the hinted letter.
+class Hint_heavy_bot : public Bot
+{
+public:
+    std::optional<Position> next_click(Model const& model) override;
+    std::string name() const override;
+};
+
+/// Makes the named bot ("perfect", "error-prone" or "hint-heavy"). Returns
+/// nullptr for an unknown name.
+std::unique_ptr<Bot> make_bot(std::string const& name,
+                              double error_rate = 0.1,
+                              unsigned seed = 1);
+
+//
+// SIMULATION
+//
+
+/// Settings for a headless game.
+struct Simulation_config
+{
+    /// Seconds of game time per frame; the default is what Controller gets
+    /// from ge211 at 60 Hz. Each frame's time passes in one step (see
+    /// Model::pass_time()), so longer frames play a game in fewer steps,
+    /// with the timers still exact; the bot just gets fewer turns.
+    double frame_dt = 1.0 / 60;
+
+    /// The bot gets a turn once every this many frames (its reaction time).
+    int frames_per_click = 1;
+
+    /// Give up on a game that is not won after this many frames.
+    long max_frames = 60L * 60 * 60;
+};
+
+/// What happened in one game.
+struct Game_result
+{
+    bool won = false;
+    int points = 0;
+    long frames = 0;
+    long clicks = 0;
+    long correct_clicks = 0;
+    long wrong_clicks = 0;
+    long words_completed = 0;
+    long words_timed_out = 0;
+};
+
+/// Plays `model` with `bot` until the goal is reached or the frame limit
+/// runs out, without a window.
+Game_result play_game(Model& model, Bot& bot, Simulation_config const& config);
+
+/// Totals over many games.
+struct Simulation_report
+{
+    long games = 0;
+    long games_won = 0;
+    double seconds = 0;
+
+    Histogram frames{};
+    Histogram points{10};
+    Histogram words_completed{};
+    Histogram wrong_clicks{};
+
+    /// Wall-clock nanoseconds per game (filled in by run_batch()).
+    Histogram game_ns{};
+
+    /// Adds one game's result.
+    void add(Game_result const& result);
+
+    /// Adds another report's games (seconds are not added).
+    void merge(Simulation_report const& other);
+
+    double games_per_second() const;
+
+    /// Prints a human-readable summary.
+    void print(std::ostream& os) const;
+};
+
+//
+// BATCH SIMULATION
+//
+
+/// Settings for running many games at once.
+struct Batch_config
+{
+    long games = 10000;
+
+    /// Worker threads; 0 means one per hardware thread.
+    unsigned threads = 0;
+
+    /// Game i is played with seed mix_seed(seed, i), so a batch gives the
+    /// same results no matter how many threads run it.
+    uint64_t seed = 1;
+
+    /// Games a worker claims at a time from its queue.
+    long chunk = 64;
+
+    std::string bot = "perfect";
+    double error_rate = 0.1;
+    Word_list list = Word_list::short_list;
+
+    /// Favor words of this difficulty (see word_selection.hxx); by default
+    /// words are picked uniformly.
+    std::optional<Difficulty> difficulty;
+
+    Simulation_config game{};
+};
+
+/// Derives a well-mixed per-game seed from a batch seed and a game number.
+uint64_t mix_seed(uint64_t seed, uint64_t index);
+
+/// Plays `config.games` independent games spread across worker threads.
+/// Each worker starts with an equal share of the games and, once it runs
+/// out, steals half of the remaining games of another worker. Each worker
+/// keeps its own statistics and merges them into the shared totals with
+/// atomic adds when it finishes. Throws std::invalid_argument for an
+/// unknown bot name.
+Simulation_report run_batch(Batch_config const& config);
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// A read-only view of a contiguous run of T (like C++20's std::span<T
+/// const>, which we cannot use while building as C++17). It does not own
+/// the elements, so it is only valid while the container it came from is
+/// alive and unmodified.
+template <class T>
+class Span
+{
+public:
+
+    using value_type = T;
+    using const_iterator = T const*;
+    using iterator = const_iterator;
+
+    Span() : data_(nullptr), size_(0) { }
+
+    Span(T const* data, size_t size) : data_(data), size_(size) { }
+
+    Span(std::vector<T> const& v) : data_(v.data()), size_(v.size()) { }
+
+    T const* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T const& operator[](size_t i) const { return data_[i]; }
+    T const& front() const { return data_[0]; }
+    T const& back() const { return data_[size_ - 1]; }
+
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    /// The elements from `offset` to the end.
+    Span subspan(size_t offset) const
+    {
+        return {data_ + offset, size_ - offset};
+    }
+
+    /// Element-wise comparison.
+    bool operator==(Span other) const
+    {
+        if (size_ != other.size_) {
+            return false;
+        }
+
+        for (size_t i = 0; i < size_; ++i) {
+            if (!(data_[i] == other.data_[i])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool operator!=(Span other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+
+    T const* data_;
+    size_t size_;
+};
@@ -1,5 +1,7 @@
 #include "view.hxx"
 
+#include <chrono>
+
 using Color = ge211::Color;
 
 
@@ -7,6 +9,16 @@ using Color = ge211::Color;
 static int const grid_size = 50;
 static int const button_radius = 40;
 
+// Layers. Sprites at the same z are drawn in no particular order, so each
+// kind of sprite gets its own z: then the sprites that share a texture
+// (every grey tile, every "E") reach the renderer back to back, and SDL
+// batches each run into one draw with one texture bind instead of
+// switching textures tile by tile. Tiles and letters never overlap others
+// of their kind, so their order within a layer doesn't matter.
+static int const tile_z = 0;
+static int const marked_tile_z = 1;
+static int const letter_z = 3;
+
 static Color const grey {132, 132, 132};
 static Color const green {0, 200, 0};
 static Color const red {255, 0, 0};
@@ -21,44 +33,51 @@ View::View(Model const& model, ge211::Mixer& mixer)
         : model_(model),
           mixer_(mixer),
           initial_window_dims({800, 600}),
+          text_(),
+          text_loading_(std::async(std::launch::async, [] {
+              return std::make_unique<Text_assets>();
+          })),
           tile_sprite({grid_size, grid_size}, grey),
           wrong_tile_sprite({grid_size, grid_size}, red),
           hint_tile_sprite({grid_size, grid_size}, green),
-          hint_button_sprite(button_radius, green)
+          hint_button_sprite(button_radius, green),
+          frame_(),
+          frame_valid_(false),
+          frame_version_(0)
 {
-
-    // Initialize all letter_sprites
-    for (char c = 'A'; c <= 'Z'; ++c) {
-        std::string letter(1, c);
-        letter_sprites_.emplace_back(letter, letter_font_);
-    }
-
     // Loads sound effect.
     if (mixer_.is_enabled()) {
         load_audio_();
     }
-
 }
 
+View::Text_assets::Text_assets()
+        : letters(letter_font, grid_size),
+          points_text(feature_font, "POINTS: "),
+          timer_text(feature_font, "TIME: "),
+          hint_sprite("HELP", feature_font),
+          goal_sprite("GOAL: " + std::to_string(Model::goal_points),
+                      feature_font)
+{ }
+
 void
 View::draw(ge211::Sprite_set& set)
 {
-    // Render the hint functionality
-    draw_hint_button_(set);
+    PROFILE_SCOPE(draw);
 
-    // Render the letters onto the screen
-    for (size_t i = 0; i < model_.word_posns().size(); i++)
-    {
-        draw_one_letter_(set, i);
-    }
+    bool const arrived = poll_assets_();
 
-    // Render the points count on the screen
-    draw_points_(set);
+    // Nothing visible has changed since the last frame, so reuse it.
+    if (arrived || !frame_valid_ || model_.version() != frame_version_) {
+        build_frame_();
+        frame_valid_ = true;
+        frame_version_ = model_.version();
+    }
 
-    // Render the timer on the screen
-    draw_timer_(set);
+    frame_.replay(set);
 }
 
+
 View::Position
 View::board_to_screen(View::Position logical)
 {
@@ -74,6 +93,12 @@ View::screen_to_board(View::Position physical)
 void
 View::play_whoosh_effect()
 {
+    poll_assets_();
+
+    if (whoosh_sound.empty()) {
+        return;
+    }
+
     if (whoosh_sound_handle.empty() || whoosh_sound_handle.get_state() ==
                                        ge211::Mixer::State::detached)
     {
@@ -93,62 +118,93 @@ View::initial_window_dimensions() const
 //
 
 void
-View::draw_one_letter_(ge211::Sprite_set& set, size_t i)
+View::build_frame_()
 {
-    auto scale = ge211::Transform::scale(2);
-    Model::Position p = model_.word_posns()[i];
+    frame_.clear();
 
-    if (p == model_.wrong_posn() && !model_.is_correct()) {
-        set.add_sprite(wrong_tile_sprite, board_to_screen(p), 0);
+    // Render the hint functionality
+    draw_hint_button_(frame_);
 
+    // Render the letters onto the screen. These are views into the model,
+    // so nothing is copied or allocated here.
+    Span<Model::Position> posns = model_.word_posns();
+    std::string_view word = model_.word();
+
+    for (size_t i = 0; i < posns.size(); i++)
+    {
+        draw_one_letter_(frame_, posns[i], word[i]);
+    }
+
+    // Render the points count on the screen
+    draw_points_(frame_);
 
+    // Render the timer on the screen
+    draw_timer_(frame_);
+}
+
+void
+View::draw_one_letter_(Draw_list& list, Position p, char letter)
+{
+    PROFILE_SCOPE(draw_one_letter);
+
+    Position const screen = board_to_screen(p);
+
+    switch (model_.tile_at(p)) {
+    case Model::Tile::wrong:
         // for changing back to normal
         if (model_.change_in_time() >= 2.0){
-            set.add_sprite(tile_sprite, board_to_screen(p), 0);
+            list.add_sprite(tile_sprite, screen, tile_z);
+        } else {
+            list.add_sprite(wrong_tile_sprite, screen, marked_tile_z);
         }
+        break;
+
+    case Model::Tile::hint:
+        list.add_sprite(hint_tile_sprite, screen, marked_tile_z);
+        break;
 
-    } else if (p == model_.hint_posn() && model_.hint()) {
-        set.add_sprite(hint_tile_sprite, board_to_screen(p), 0);
-    } else {
-        set.add_sprite(tile_sprite, board_to_screen(p), 0);
+    default:
+        list.add_sprite(tile_sprite, screen, tile_z);
+        break;
     }
 
-    auto letter_index = model_.word()[i] - 'a';
-    auto const& letter = letter_sprites_.at(letter_index);
-    Model::Position letter_p = board_to_screen(p);
-    set.add_sprite(letter,{letter_p.x + (grid_size / 3), letter_p.y},3,
-                   scale);
+    if (!text_) {
+        return;
+    }
+
+    // One layer per letter, for batching (see letter_z).
+    Position const offset = text_->letters.offset(letter);
+    list.add_sprite(text_->letters.sprite(letter),
+                    {screen.x + offset.x, screen.y + offset.y},
+                    letter_z + (letter - 'a'));
 }
 
 void
-View::draw_timer_(ge211::Sprite_set& set)
+View::draw_timer_(Draw_list& list)
 {
-    ge211::Text_sprite::Builder timer_builder(feature_font_);
-    timer_builder << "TIME: " << model_.time_remaining() / 60;
-    timer_sprite.reconfigure(timer_builder);
-    set.add_sprite(timer_sprite, {5, 560});
+    PROFILE_SCOPE(draw_timer);
+
+    if (text_) {
+        list.add_sprite(text_->timer_text.show(model_.seconds_remaining()),
+                        {5, 560});
+    }
 }
 
 void
-View::draw_points_(ge211::Sprite_set& set)
+View::draw_points_(Draw_list& list)
 {
-    ge211::Text_sprite::Builder points_builder(feature_font_);
-    points_builder << "POINTS: " << model_.points();
-    points_sprite.reconfigure(points_builder);
-    set.add_sprite(points_sprite, {5, 0});
-
-    ge211::Text_sprite::Builder goal_builder(feature_font_);
-    goal_builder << "GOAL: 2500";
-    goal_sprite.reconfigure(goal_builder);
-    set.add_sprite(goal_sprite, {5, 28});
+    PROFILE_SCOPE(draw_points);
+
+    if (text_) {
+        list.add_sprite(text_->points_text.show(model_.points()), {5, 0});
+        list.add_sprite(text_->goal_sprite, {5, 28});
+    }
 }
 
 void
-View::draw_hint_button_(ge211::Sprite_set& set)
+View::draw_hint_button_(Draw_list& list)
 {
-    ge211::Text_sprite::Builder hint_builder(feature_font_);
-    hint_builder << "HELP";
-    hint_sprite.reconfigure(hint_builder);
+    PROFILE_SCOPE(draw_hint_button);
 
     // Find position for the word 'hint' on top of the hint button.
     ge211::Posn<int> physical_hint_posn = board_to_screen(model_
@@ -158,13 +214,46 @@ View::draw_hint_button_(ge211::Sprite_set& set)
                                       physical_hint_posn.y +
                                       (button_radius / 2)};
 
-    set.add_sprite(hint_sprite, hint_word_loc, 2);
-    set.add_sprite(hint_button_sprite, board_to_screen(model_.hint_button_posn
+    if (text_) {
+        list.add_sprite(text_->hint_sprite, hint_word_loc, 2);
+    }
+    list.add_sprite(hint_button_sprite, board_to_screen(model_.hint_button_posn
                                                                      ()), 0);
 }
 
 void
 View::load_audio_()
 {
-    whoosh_sound.try_load(whoosh_filename, mixer_);
+    // Decoding the MP3 is slow, and needs nothing from the main thread.
+    sound_loading_ = std::async(std::launch::async, [&mixer = mixer_] {
+        ge211::Sound_effect sound;
+        sound.try_load(whoosh_filename, mixer);
+        return sound;
+    });
+}
+
+bool
+View::poll_assets_()
+{
+    auto ready = [](auto const& future) {
+        return future.valid() &&
+               future.wait_for(std::chrono::seconds(0)) ==
+               std::future_status::ready;
+    };
+
+    bool arrived = false;
+
+    // get() rethrows anything loading threw (say, a missing font), here
+    // on the main thread.
+    if (ready(text_loading_)) {
+        text_ = text_loading_.get();
+        arrived = true;
+    }
+
+    if (ready(sound_loading_)) {
+        whoosh_sound = sound_loading_.get();
+        arrived = true;
+    }
+
+    return arrived;
 }
\ No newline at end of file
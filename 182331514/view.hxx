@@ -1,7 +1,13 @@
 #pragma once
 
+#include "draw_list.hxx"
+#include "hud_text.hxx"
+#include "letter_glyphs.hxx"
 #include "model.hxx"
 
+#include <future>
+#include <memory>
+
 class View
 {
 public:
@@ -13,6 +19,8 @@ public:
     // CONSTRUCTOR
     //
 
+    /// Starts loading the fonts and the sound in the background and returns
+    /// at once, so the first frame doesn't wait for them (see draw()).
     explicit View(Model const& model, ge211::Mixer& mixer);
 
     //
@@ -20,7 +28,12 @@ public:
     //
 
     /// Renders sprites onto the screen, including the letters and their
-    /// tiles, the hint button, the timer and the points.
+    /// tiles, the hint button, the timer and the points. The sprite list is
+    /// only rebuilt when the model's version() has changed (or assets have
+    /// arrived); otherwise the previous frame's list is replayed as is.
+    ///
+    /// Until the fonts have loaded, frames show only the tiles and the
+    /// hint button; the text appears on the first frame after they're in.
     void draw(ge211::Sprite_set& set);
 
     /// Translates board positions to screen positions.
@@ -29,7 +42,8 @@ public:
     /// Translates screen positions to board positions.
     Position screen_to_board(Position physical);
 
-    /// Plays a sound effect when the wrong letter is clicked.
+    /// Plays a sound effect when the wrong letter is clicked (unless it
+    /// hasn't loaded yet).
     void play_whoosh_effect();
 
     /// Defines initial window dimensions. Called by Controller to override.
@@ -45,13 +59,35 @@ private:
     ge211::Mixer& mixer_;
     Dimensions initial_window_dims;
 
-    // Text and letters.
-    ge211::Font letter_font_{"sans.ttf", 16};
-    ge211::Font feature_font_{"sans.ttf", 24};
-    ge211::Text_sprite points_sprite;
-    ge211::Text_sprite timer_sprite;
-    ge211::Text_sprite hint_sprite;
-    ge211::Text_sprite goal_sprite;
+    /// Everything drawn with a font. Opening the font file and rendering
+    /// the alphabet are the slow part of starting up, so this is built on
+    /// a background thread. It never moves once built (the HUD text holds
+    /// a reference to its font).
+    struct Text_assets
+    {
+        Text_assets();
+
+        // Letters are rendered at the size they're shown (this used to be
+        // 16pt, drawn scaled up 2x).
+        ge211::Font letter_font{"sans.ttf", 32};
+        ge211::Font feature_font{"sans.ttf", 24};
+
+        // The whole alphabet, rendered once.
+        Letter_glyphs letters;
+
+        // Changing HUD text: only re-rendered when the number shown
+        // changes.
+        Hud_text points_text;
+        Hud_text timer_text;
+
+        // Constant HUD text: rendered once.
+        ge211::Text_sprite const hint_sprite;
+        ge211::Text_sprite const goal_sprite;
+    };
+
+    // Null until loaded; see poll_assets_().
+    std::unique_ptr<Text_assets> text_;
+    std::future<std::unique_ptr<Text_assets>> text_loading_;
 
     // Tiles and hint.
     ge211::Rectangle_sprite const tile_sprite;
@@ -59,30 +95,40 @@ private:
     ge211::Rectangle_sprite const hint_tile_sprite;
     ge211::Circle_sprite const hint_button_sprite;
 
-    // The whole alphabet in text_sprites.
-    std::vector<ge211::Text_sprite> letter_sprites_;
-
-    // Sound effects.
+    // Sound effects. whoosh_sound is empty until loaded.
     ge211::Sound_effect whoosh_sound;
     ge211::Sound_effect_handle whoosh_sound_handle;
+    std::future<ge211::Sound_effect> sound_loading_;
+
+    // The last frame built, and the model version it was built from.
+    Draw_list frame_;
+    bool frame_valid_;
+    uint64_t frame_version_;
 
     //
     // PRIVATE HELPER FUNCTIONS
     //
 
-    /// Draws one letter onto the screen given an index for the word and word
-    /// positions.
-    void draw_one_letter_(ge211::Sprite_set& set, size_t i);
+    /// Builds the whole frame into frame_.
+    void build_frame_();
+
+    /// Draws one letter (and its tile) onto the screen at board position p.
+    void draw_one_letter_(Draw_list& list, Position p, char letter);
 
     /// Draws and updates the timer onto the screen.
-    void draw_timer_(ge211::Sprite_set& set);
+    void draw_timer_(Draw_list& list);
 
     /// Draws and updates the points onto the screen.
-    void draw_points_(ge211::Sprite_set& set);
+    void draw_points_(Draw_list& list);
 
     /// Draws and updates the hint button onto the screen.
-    void draw_hint_button_(ge211::Sprite_set& set);
+    void draw_hint_button_(Draw_list& list);
 
-    /// Loads the sound effect. Called by Constructor.
+    /// Starts decoding the sound effect in the background. Called by
+    /// Constructor.
     void load_audio_();
+
+    /// Takes whatever the background loads have finished, without waiting
+    /// for the rest. Returns whether anything arrived.
+    bool poll_assets_();
 };
@@ -0,0 +1,230 @@
+#include "word_bank.hxx"
+
+#include <stdexcept>
+
+//
+// CONSTRUCTORS
+//
+
+Word_bank::Word_bank()
+        : data_(nullptr),
+          chars_(),
+          offsets_(),
+          width_(0),
+          size_(0),
+          view_(false)
+{ }
+
+Word_bank::Word_bank(std::vector<std::string> const& words)
+        : Word_bank()
+{
+    pack_(words.size(), [&](size_t i) {
+        return std::string_view(words[i]);
+    });
+}
+
+Word_bank::Word_bank(std::vector<std::string_view> const& words)
+        : Word_bank()
+{
+    pack_(words.size(), [&](size_t i) { return words[i]; });
+}
+
+Word_bank::Word_bank(Dictionary const& dictionary)
+        : Word_bank(dictionary.words())
+{ }
+
+Word_bank
+Word_bank::view_fixed(std::string_view letters, size_t width)
+{
+    if (width == 0 || letters.size() % width != 0) {
+        throw std::invalid_argument("Word_bank::view_fixed: bad width");
+    }
+
+    Word_bank result;
+    result.data_ = letters.data();
+    result.width_ = width;
+    result.size_ = letters.size() / width;
+    result.view_ = true;
+    return result;
+}
+
+Word_bank::Word_bank(Word_bank const& other)
+        : data_(other.data_),
+          chars_(other.chars_),
+          offsets_(other.offsets_),
+          width_(other.width_),
+          size_(other.size_),
+          view_(other.view_)
+{
+    if (!view_) {
+        data_ = chars_.data();
+    }
+}
+
+Word_bank::Word_bank(Word_bank&& other) noexcept
+        : data_(other.data_),
+          chars_(std::move(other.chars_)),
+          offsets_(std::move(other.offsets_)),
+          width_(other.width_),
+          size_(other.size_),
+          view_(other.view_)
+{
+    if (!view_) {
+        data_ = chars_.data();
+    }
+
+    other.data_ = nullptr;
+    other.chars_.clear();
+    other.offsets_.clear();
+    other.width_ = 0;
+    other.size_ = 0;
+    other.view_ = false;
+}
+
+Word_bank&
+Word_bank::operator=(Word_bank const& other)
+{
+    if (this != &other) {
+        *this = Word_bank(other);
+    }
+
+    return *this;
+}
+
+Word_bank&
+Word_bank::operator=(Word_bank&& other) noexcept
+{
+    if (this != &other) {
+        chars_ = std::move(other.chars_);
+        offsets_ = std::move(other.offsets_);
+        width_ = other.width_;
+        size_ = other.size_;
+        view_ = other.view_;
+        data_ = view_ ? other.data_ : chars_.data();
+
+        other.data_ = nullptr;
+        other.chars_.clear();
+        other.offsets_.clear();
+        other.width_ = 0;
+        other.size_ = 0;
+        other.view_ = false;
+    }
+
+    return *this;
+}
+
+
+//
+// ACCESSORS
+//
+
+size_t
+Word_bank::size() const
+{
+    return size_;
+}
+
+bool
+Word_bank::empty() const
+{
+    return size_ == 0;
+}
+
+std::string_view
+Word_bank::operator[](size_t i) const
+{
+    if (width_ != 0) {
+        return {data_ + i * width_, width_};
+    }
+
+    return {data_ + offsets_[i], offsets_[i + 1] - offsets_[i]};
+}
+
+Word_bank::const_iterator
+Word_bank::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+Word_bank::const_iterator
+Word_bank::end() const
+{
+    return const_iterator(this, size_);
+}
+
+bool
+Word_bank::is_fixed_width() const
+{
+    return width_ != 0;
+}
+
+size_t
+Word_bank::word_width() const
+{
+    return width_;
+}
+
+size_t
+Word_bank::storage_bytes() const
+{
+    return chars_.size() + offsets_.size() * sizeof(uint32_t);
+}
+
+bool
+Word_bank::is_view() const
+{
+    return view_;
+}
+
+
+//
+// PRIVATE HELPERS
+//
+
+template <class GET>
+void
+Word_bank::pack_(size_t count, GET get)
+{
+    // First pass: total size, and whether all the words are one width.
+    size_t total = 0;
+    size_t width = count > 0 ? get(0).size() : 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        size_t length = get(i).size();
+        total += length;
+
+        if (length != width) {
+            width = 0;
+        }
+    }
+
+    if (total > UINT32_MAX) {
+        throw std::length_error("Word_bank: word list too large");
+    }
+
+    // Second pass: copy the letters into one buffer.
+    chars_.clear();
+    chars_.reserve(total);
+    offsets_.clear();
+
+    if (width == 0 && count > 0) {
+        offsets_.reserve(count + 1);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (width == 0) {
+            offsets_.push_back(uint32_t(chars_.size()));
+        }
+
+        chars_.append(get(i));
+    }
+
+    if (width == 0 && count > 0) {
+        offsets_.push_back(uint32_t(chars_.size()));
+    }
+
+    data_ = chars_.data();
+    width_ = width;
+    size_ = count;
+    view_ = false;
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "dictionary.hxx"
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// A compact, read-only list of words. All the letters live in one
+/// contiguous buffer. When every word has the same length (as in both
+/// bundled dictionaries) the words are stored as fixed-width records with no
+/// per-word overhead at all; otherwise an offset table is kept alongside.
+///
+/// Words are handed out as std::string_views into the buffer, so reading
+/// them never copies. A Word_bank can also be a view of fixed-width records
+/// in static storage (see view_fixed()), in which case it owns nothing and
+/// copying it is free.
+class Word_bank
+{
+public:
+
+    /// Random-access iterator over the words. Dereferences to a
+    /// std::string_view by value.
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        const_iterator() = default;
+
+        std::string_view operator*() const
+        { return (*bank_)[index_]; }
+
+        std::string_view operator[](difference_type n) const
+        { return (*bank_)[index_ + size_t(n)]; }
+
+        const_iterator& operator++() { ++index_; return *this; }
+        const_iterator operator++(int) { auto old = *this; ++index_; return old; }
+        const_iterator& operator--() { --index_; return *this; }
+        const_iterator operator--(int) { auto old = *this; --index_; return old; }
+
+        const_iterator& operator+=(difference_type n)
+        { index_ += size_t(n); return *this; }
+        const_iterator& operator-=(difference_type n)
+        { index_ -= size_t(n); return *this; }
+
+        const_iterator operator+(difference_type n) const
+        { return const_iterator(bank_, index_ + size_t(n)); }
+        const_iterator operator-(difference_type n) const
+        { return const_iterator(bank_, index_ - size_t(n)); }
+        difference_type operator-(const_iterator other) const
+        { return difference_type(index_) - difference_type(other.index_); }
+
+        bool operator==(const_iterator other) const
+        { return index_ == other.index_; }
+        bool operator!=(const_iterator other) const
+        { return index_ != other.index_; }
+        bool operator<(const_iterator other) const
+        { return index_ < other.index_; }
+        bool operator<=(const_iterator other) const
+        { return index_ <= other.index_; }
+        bool operator>(const_iterator other) const
+        { return index_ > other.index_; }
+        bool operator>=(const_iterator other) const
+        { return index_ >= other.index_; }
+
+        friend const_iterator operator+(difference_type n, const_iterator i)
+        { return i + n; }
+
+    private:
+        friend class Word_bank;
+
+        const_iterator(Word_bank const* bank, size_t index)
+                : bank_(bank), index_(index)
+        { }
+
+        Word_bank const* bank_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    //
+    // CONSTRUCTORS
+    //
+
+    /// An empty word bank.
+    Word_bank();
+
+    /// Packs a copy of the given words.
+    explicit Word_bank(std::vector<std::string> const& words);
+
+    /// Packs a copy of the given words.
+    explicit Word_bank(std::vector<std::string_view> const& words);
+
+    /// Packs a copy of the words of a loaded dictionary.
+    explicit Word_bank(Dictionary const& dictionary);
+
+    /// A Word_bank that views `letters`, which holds fixed-width records of
+    /// `width` letters each, without copying them. `letters` must outlive
+    /// the result (and any copies of it).
+    static Word_bank view_fixed(std::string_view letters, size_t width);
+
+    Word_bank(Word_bank const& other);
+    Word_bank(Word_bank&& other) noexcept;
+    Word_bank& operator=(Word_bank const& other);
+    Word_bank& operator=(Word_bank&& other) noexcept;
+
+    //
+    // ACCESSORS
+    //
+
+    size_t size() const;
+    bool empty() const;
+
+    /// The i-th word. Valid until this Word_bank is modified or destroyed.
+    std::string_view operator[](size_t i) const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /// Whether every word has the same length (fixed-width records).
+    bool is_fixed_width() const;
+
+    /// The common word length if is_fixed_width(), otherwise 0.
+    size_t word_width() const;
+
+    /// Bytes of storage used by the words (letters plus offset table).
+    size_t storage_bytes() const;
+
+    /// Whether the letters live in external storage (see view_fixed()).
+    bool is_view() const;
+
+private:
+
+    /// All the letters, back to back, with no separators. Points either
+    /// into chars_ or, for a view, into external storage.
+    char const* data_;
+
+    /// Owned letters (empty for a view).
+    std::string chars_;
+
+    /// Start of each word in chars_, plus one past the end. Empty in
+    /// fixed-width mode, where word i starts at i * width_.
+    std::vector<uint32_t> offsets_;
+
+    size_t width_;
+    size_t size_;
+    bool view_;
+
+    /// Packs `count` words, where `get(i)` returns the i-th.
+    template <class GET>
+    void pack_(size_t count, GET get);
+};
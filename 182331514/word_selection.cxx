@@ -0,0 +1,191 @@
+#include "word_selection.hxx"
+#include "embedded_dictionary.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <numeric>
+#include <optional>
+
+// Relative frequency of each letter in English text, in percent.
+static double const letter_frequency[26] = {
+        8.2, 1.5, 2.8, 4.3, 12.7, 2.2, 2.0, 6.1, 7.0, 0.15, 0.77, 4.0, 2.4,
+        6.7, 7.5, 1.9, 0.095, 6.0, 6.3, 9.1, 2.8, 0.98, 2.4, 0.15, 2.0, 0.074,
+};
+
+// Raw score added per repeated letter, and for an uncommon word.
+static double const repeat_penalty = 2.0;
+static double const uncommon_penalty = 4.0;
+
+//
+// ALIAS SAMPLING
+//
+
+Alias_sampler::Alias_sampler(Span<double> weights)
+        : threshold_(weights.size()),
+          alias_(weights.size())
+{
+    size_t const n = weights.size();
+
+    double total = 0;
+    for (double w : weights) {
+        total += std::max(0.0, w);
+    }
+
+    // Each slot's probability, scaled so the average is 1.
+    std::vector<double> scaled(n);
+    for (size_t i = 0; i < n; ++i) {
+        scaled[i] = total > 0 ? std::max(0.0, weights[i]) * double(n) / total
+                              : 1.0;
+    }
+
+    std::vector<uint32_t> small, large;
+    for (size_t i = 0; i < n; ++i) {
+        (scaled[i] < 1.0 ? small : large).push_back(uint32_t(i));
+    }
+
+    // Fill each under-full slot with its own weight and top it up from an
+    // over-full one.
+    while (!small.empty() && !large.empty()) {
+        uint32_t s = small.back();
+        small.pop_back();
+        uint32_t l = large.back();
+
+        threshold_[s] = uint64_t(std::ldexp(scaled[s], 32));
+        alias_[s] = l;
+
+        scaled[l] -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+
+    // What's left is full (up to rounding).
+    for (uint32_t i : large) {
+        threshold_[i] = uint64_t(1) << 32;
+        alias_[i] = i;
+    }
+    for (uint32_t i : small) {
+        threshold_[i] = uint64_t(1) << 32;
+        alias_[i] = i;
+    }
+}
+
+//
+// WORD DIFFICULTY
+//
+
+std::vector<double>
+difficulty_scores(Word_bank const& bank, size_t common_count)
+{
+    size_t const n = bank.size();
+
+    std::vector<double> raw(n);
+    for (size_t i = 0; i < n; ++i) {
+        bool seen[26] = {};
+        double score = i < common_count ? 0.0 : uncommon_penalty;
+
+        for (char c : bank[i]) {
+            if (c < 'a' || c > 'z') {
+                continue;
+            }
+            if (seen[c - 'a']) {
+                score += repeat_penalty;
+            } else {
+                seen[c - 'a'] = true;
+                score += -std::log2(letter_frequency[c - 'a'] / 100);
+            }
+        }
+
+        raw[i] = score;
+    }
+
+    // Replace scores by rank (ties share the lower rank).
+    std::vector<uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return raw[a] < raw[b];
+    });
+
+    std::vector<double> scores(n);
+    size_t rank = 0;
+    for (size_t k = 0; k < n; ++k) {
+        if (k > 0 && raw[order[k]] != raw[order[k - 1]]) {
+            rank = k;
+        }
+        scores[order[k]] = n > 1 ? double(rank) / double(n - 1) : 0.0;
+    }
+
+    return scores;
+}
+
+Difficulty_curve
+Difficulty_curve::of(Difficulty tier)
+{
+    switch (tier) {
+    case Difficulty::easy:
+        return {0.15, 0.15};
+    case Difficulty::hard:
+        return {0.85, 0.15};
+    default:
+        return {0.5, 0.15};
+    }
+}
+
+static std::vector<double>
+curve_weights_(Span<double> scores, Difficulty_curve curve)
+{
+    std::vector<double> weights;
+    weights.reserve(scores.size());
+
+    double const spread = std::max(curve.spread, 1e-6);
+    for (double d : scores) {
+        double z = (d - curve.target) / spread;
+        weights.push_back(std::exp(-0.5 * z * z));
+    }
+
+    return weights;
+}
+
+Word_selector::Word_selector(Span<double> scores, Difficulty_curve curve)
+        : sampler_(curve_weights_(scores, curve)),
+          curve_(curve)
+{ }
+
+//
+// EMBEDDED LISTS
+//
+
+std::vector<double> const&
+embedded_difficulty_scores(Word_list list)
+{
+    static std::once_flag once[3];
+    static std::vector<double> scores[3];
+
+    size_t const l = size_t(list);
+    std::call_once(once[l], [=] {
+        Word_bank bank = embedded_word_bank(list);
+        size_t common = list == Word_list::long_list
+                        ? 0
+                        : embedded_word_bank(Word_list::short_list).size();
+        scores[l] = difficulty_scores(bank, common);
+    });
+
+    return scores[l];
+}
+
+Word_selector const&
+embedded_word_selector(Word_list list, Difficulty tier)
+{
+    static std::once_flag once[3][3];
+    static std::optional<Word_selector> selectors[3][3];
+
+    size_t const l = size_t(list), t = size_t(tier);
+    std::call_once(once[l][t], [=] {
+        selectors[l][t].emplace(embedded_difficulty_scores(list),
+                                Difficulty_curve::of(tier));
+    });
+
+    return *selectors[l][t];
+}
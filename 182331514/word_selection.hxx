@@ -0,0 +1,161 @@
+#pragma once
+
+#include "dictionary.hxx"
+#include "random.hxx"
+#include "span.hxx"
+#include "word_bank.hxx"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+//
+// ALIAS SAMPLING
+//
+
+/// Draws index i from 0 to n - 1 with probability weight[i] / sum(weights),
+/// in constant time per draw however large n is (Walker's alias method, as
+/// built by Vose). Each slot holds a threshold and an alias: a draw picks a
+/// slot uniformly, then keeps it or takes its alias by one more random
+/// number.
+class Alias_sampler
+{
+public:
+
+    /// Builds the table in O(n). Weights must be non-negative, with at
+    /// least one positive; otherwise every index is equally likely.
+    explicit Alias_sampler(Span<double> weights);
+
+    size_t size() const { return alias_.size(); }
+
+    /// One random index.
+    template <class RNG>
+    size_t sample(RNG& rng) const
+    {
+        uint32_t slot = random_below(rng, uint32_t(alias_.size()));
+        return uint32_t(rng()) < threshold_[slot] ? slot : alias_[slot];
+    }
+
+private:
+
+    /// A slot is kept if a random 32-bit number is below its threshold
+    /// (2^32 means always).
+    std::vector<uint64_t> threshold_;
+    std::vector<uint32_t> alias_;
+};
+
+//
+// REPEAT-FREE ORDER
+//
+
+/// Deals word indices from 0 to n - 1 in a shuffled order without repeats:
+/// every index comes up once before any comes up again. The order is an
+/// Index_permutation, so all it keeps is a key and a count of how many
+/// indices it has dealt, rather than a shuffled copy of the bank. After
+/// n indices it starts a new pass in a new order.
+class Word_schedule
+{
+public:
+
+    explicit Word_schedule(uint64_t seed = 0)
+            : key_(key_for_(seed)),
+              dealt_(0)
+    { }
+
+    /// The next index below n. If n changes, a new pass starts once the
+    /// count reaches it.
+    size_t next(size_t n)
+    {
+        if (dealt_ >= n) {
+            splitmix64(key_);
+            dealt_ = 0;
+        }
+        return Index_permutation(uint32_t(n), key_)(dealt_++);
+    }
+
+    /// How many indices of the current pass have been dealt.
+    uint32_t dealt() const { return dealt_; }
+
+private:
+
+    // Salted, so the key isn't the state a Model_rng with the same seed
+    // starts from.
+    static uint64_t key_for_(uint64_t seed)
+    {
+        seed ^= 0x6A09E667F3BCC909ULL;
+        return splitmix64(seed);
+    }
+
+    uint64_t key_;
+    uint32_t dealt_;
+};
+
+//
+// WORD DIFFICULTY
+//
+
+/// How hard a word is to unscramble, from 0 (easiest) to 1 (hardest),
+/// computed for every word of a bank. A word's raw score adds up:
+///
+///   - the rarity of its letters in English text (-log2 of frequency), so
+///     "xylyl" scores far above "arise";
+///   - a penalty for each repeated letter, which makes for fewer distinct
+///     tiles to go on;
+///   - a penalty for not being one of the bank's common words.
+///
+/// Scores are then replaced by their rank, so a bank's words are spread
+/// evenly over 0 to 1 and a third of them are always in each tier.
+///
+/// `common_count` says how many of the bank's first words are common ones;
+/// embedded_word_bank() puts the short (common) list first.
+std::vector<double> difficulty_scores(Word_bank const& bank,
+                                      size_t common_count);
+
+/// Ready-made difficulty targets.
+enum class Difficulty { easy, medium, hard };
+
+/// Which words to favor: weight exp(-(d - target)^2 / (2 spread^2)) for a
+/// word of difficulty d. A large spread gets close to uniform.
+struct Difficulty_curve
+{
+    double target = 0.5;
+    double spread = 0.15;
+
+    /// The curve for a tier: centred on 0.15, 0.5 or 0.85.
+    static Difficulty_curve of(Difficulty tier);
+};
+
+/// Picks word indices for a word bank following a Difficulty_curve, in
+/// constant time per pick. Built once and never changed, so any number of
+/// Models (on any threads) can share one. See Model::set_word_selector().
+class Word_selector
+{
+public:
+
+    Word_selector(Span<double> scores, Difficulty_curve curve);
+
+    /// Number of words it picks from.
+    size_t size() const { return sampler_.size(); }
+
+    /// The curve it was built for.
+    Difficulty_curve curve() const { return curve_; }
+
+    template <class RNG>
+    size_t pick(RNG& rng) const
+    {
+        return sampler_.sample(rng);
+    }
+
+private:
+
+    Alias_sampler sampler_;
+    Difficulty_curve curve_;
+};
+
+/// The difficulty scores of embedded_word_bank(list), computed the first
+/// time they're asked for and then shared.
+std::vector<double> const& embedded_difficulty_scores(Word_list list);
+
+/// A selector for embedded_word_bank(list) at the given tier, built the
+/// first time it's asked for and then shared.
+Word_selector const& embedded_word_selector(Word_list list, Difficulty tier);
@@ -0,0 +1,422 @@
+#include "word_source.hxx"
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#define WORD_SCRAMBLE_HAVE_INOTIFY 1
+#endif
+
+// How long the watcher waits for more changes before reloading, so that a
+// save that touches the file several times reloads once.
+static int const settle_ms = 50;
+
+// How often the watcher wakes up with nothing to do, to free old lists.
+static int const collect_ms = 1000;
+
+static Difficulty const all_tiers[] = {
+        Difficulty::easy, Difficulty::medium, Difficulty::hard,
+};
+
+// Appends the non-empty lines of `text` to `words`, the way Dictionary
+// reads its files.
+static void
+split_lines_(std::string_view text, std::vector<std::string_view>& words)
+{
+    while (!text.empty()) {
+        size_t end = std::min(text.find('\n'), text.size());
+        std::string_view line = text.substr(0, end);
+        text.remove_prefix(std::min(end + 1, text.size()));
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+
+        if (!line.empty()) {
+            words.push_back(line);
+        }
+    }
+}
+
+//
+// WORD LISTS
+//
+
+Word_lists::Word_lists(Word_bank bank, size_t common_count)
+        : bank_(std::move(bank)),
+          anagrams_(bank_),
+          scores_(difficulty_scores(bank_, common_count)),
+          selectors_(),
+          generation_(0),
+          users_(0)
+{
+    for (Difficulty tier : all_tiers) {
+        selectors_.emplace_back(scores_, Difficulty_curve::of(tier));
+    }
+}
+
+Word_selector const&
+Word_lists::selector(Difficulty tier) const
+{
+    return selectors_[size_t(tier)];
+}
+
+Word_selector const*
+Word_lists::matching_selector(Word_selector const& other) const
+{
+    for (Word_selector const& selector : selectors_) {
+        if (selector.curve().target == other.curve().target &&
+            selector.curve().spread == other.curve().spread) {
+            return &selector;
+        }
+    }
+
+    return nullptr;
+}
+
+//
+// REFS
+//
+
+Word_source::Ref::Ref(Word_lists const* lists)
+        : lists_(lists)
+{ }
+
+Word_source::Ref::Ref(Ref const& other)
+        : lists_(other.lists_)
+{
+    if (lists_) {
+        lists_->users_.fetch_add(1);
+    }
+}
+
+Word_source::Ref::Ref(Ref&& other) noexcept
+        : lists_(other.lists_)
+{
+    other.lists_ = nullptr;
+}
+
+Word_source::Ref&
+Word_source::Ref::operator=(Ref other) noexcept
+{
+    std::swap(lists_, other.lists_);
+    return *this;
+}
+
+Word_source::Ref::~Ref()
+{
+    if (lists_) {
+        lists_->users_.fetch_sub(1);
+    }
+}
+
+//
+// CONSTRUCTORS
+//
+
+Word_source::Word_source(Word_list list, std::string directory)
+        : list_(list),
+          directory_(std::move(directory)),
+          from_files_(true),
+          current_(nullptr),
+          generation_(0),
+          epoch_(0),
+          readers_{},
+          writer_mutex_(),
+          retired_(),
+          watcher_(),
+          stop_fd_(-1)
+{
+    // Settle on one directory, so that the files read and the directory
+    // watched are always the same.
+    if (directory_.empty()) {
+        std::string const& name = Dictionary::filename(
+                list == Word_list::long_list ? Word_list::long_list
+                                             : Word_list::short_list);
+        std::string path = Dictionary::resource_path(name);
+        directory_ = path.substr(0, path.size() - name.size());
+    } else if (directory_.back() != '/') {
+        directory_ += '/';
+    }
+
+    size_t common_count;
+    Word_bank bank = read_files_(common_count);
+    publish(std::move(bank), common_count);
+}
+
+Word_source::Word_source(Word_bank bank, size_t common_count)
+        : list_(Word_list::short_list),
+          directory_(),
+          from_files_(false),
+          current_(nullptr),
+          generation_(0),
+          epoch_(0),
+          readers_{},
+          writer_mutex_(),
+          retired_(),
+          watcher_(),
+          stop_fd_(-1)
+{
+    publish(std::move(bank), common_count);
+}
+
+Word_source::~Word_source()
+{
+#ifdef WORD_SCRAMBLE_HAVE_INOTIFY
+    if (watcher_.joinable()) {
+        uint64_t one = 1;
+        (void) ::write(stop_fd_, &one, sizeof one);
+        watcher_.join();
+        ::close(stop_fd_);
+    }
+#endif
+
+    delete current_.load();
+}
+
+//
+// PUBLIC FUNCTIONS
+//
+
+Word_source::Ref
+Word_source::current() const
+{
+    unsigned const side = epoch_.load() & 1;
+    readers_[side].fetch_add(1);
+
+    Word_lists const* lists = current_.load();
+    lists->users_.fetch_add(1);
+
+    readers_[side].fetch_sub(1);
+    return Ref(lists);
+}
+
+uint64_t
+Word_source::generation() const
+{
+    return generation_.load();
+}
+
+void
+Word_source::publish(Word_bank bank, size_t common_count)
+{
+    // Built before taking the lock, since this is the slow part.
+    auto fresh = std::make_unique<Word_lists>(std::move(bank), common_count);
+
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+
+    Word_lists* old = current_.load();
+    fresh->generation_ = old ? old->generation_ + 1 : 1;
+
+    // Announced before the swap: a Model that sees it early takes the old
+    // lists once more, and notices the difference again at its next word.
+    generation_.store(fresh->generation_);
+    current_.store(fresh.release());
+
+    if (old) {
+        synchronize_();
+        retired_.emplace_back(old);
+    }
+
+    collect_locked_();
+}
+
+bool
+Word_source::reload()
+{
+    if (!from_files_) {
+        return false;
+    }
+
+    size_t common_count;
+    Word_bank bank;
+    try {
+        bank = read_files_(common_count);
+    } catch (std::runtime_error const&) {
+        return false;
+    }
+
+    publish(std::move(bank), common_count);
+    return true;
+}
+
+void
+Word_source::collect()
+{
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    collect_locked_();
+}
+
+size_t
+Word_source::retired_count() const
+{
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    return retired_.size();
+}
+
+void
+Word_source::watch()
+{
+#ifdef WORD_SCRAMBLE_HAVE_INOTIFY
+    if (!from_files_ || watcher_.joinable()) {
+        return;
+    }
+
+    int inotify_fd = ::inotify_init1(IN_CLOEXEC);
+    if (inotify_fd < 0) {
+        throw std::system_error(errno, std::generic_category(),
+                                "inotify_init1");
+    }
+
+    // Watch the directory rather than the files, since editors and
+    // deployment scripts often replace a file by renaming a new one over
+    // it.
+    std::string dir = directory_.empty() ? "." : directory_;
+    if (::inotify_add_watch(inotify_fd, dir.c_str(),
+                            IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        int error = errno;
+        ::close(inotify_fd);
+        throw std::system_error(error, std::generic_category(),
+                                "inotify_add_watch: " + dir);
+    }
+
+    stop_fd_ = ::eventfd(0, EFD_CLOEXEC);
+    if (stop_fd_ < 0) {
+        int error = errno;
+        ::close(inotify_fd);
+        throw std::system_error(error, std::generic_category(), "eventfd");
+    }
+
+    watcher_ = std::thread([this, inotify_fd] {
+        watch_loop_(inotify_fd);
+        ::close(inotify_fd);
+    });
+#endif
+}
+
+//
+// PRIVATE HELPER FUNCTIONS
+//
+
+void
+Word_source::synchronize_() const
+{
+    // Readers that entered before a flip are on the old side; after
+    // waiting out both sides, every reader that could have loaded the old
+    // pointer has taken its reference (or not) and left.
+    for (int i = 0; i < 2; ++i) {
+        unsigned const side = epoch_.fetch_add(1) & 1;
+        while (readers_[side].load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void
+Word_source::collect_locked_()
+{
+    auto unused = [](std::unique_ptr<Word_lists> const& lists) {
+        return lists->users_.load() == 0;
+    };
+
+    retired_.erase(std::remove_if(retired_.begin(), retired_.end(), unused),
+                   retired_.end());
+}
+
+Word_bank
+Word_source::read_files_(size_t& common_count) const
+{
+    // Reserved so that the words' views never move.
+    std::vector<std::string> texts;
+    texts.reserve(2);
+    std::vector<std::string_view> words;
+    common_count = 0;
+
+    for (Word_list one : {Word_list::short_list, Word_list::long_list}) {
+        if (list_ != Word_list::both && list_ != one) {
+            continue;
+        }
+
+        // Read rather than mapped: the file may be rewritten while it's
+        // in use, and a mapping of a truncated file faults.
+        std::string path = directory_ + Dictionary::filename(one);
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("could not read dictionary: " + path);
+        }
+        texts.emplace_back(std::istreambuf_iterator<char>(in),
+                           std::istreambuf_iterator<char>());
+        split_lines_(texts.back(), words);
+
+        if (one == Word_list::short_list) {
+            common_count = words.size();
+        }
+    }
+
+    if (words.empty()) {
+        throw std::runtime_error("no words in dictionary: " + directory_);
+    }
+
+    return Word_bank(words);
+}
+
+void
+Word_source::watch_loop_(int inotify_fd)
+{
+#ifdef WORD_SCRAMBLE_HAVE_INOTIFY
+    std::string const names[] = {
+            Dictionary::filename(Word_list::short_list),
+            Dictionary::filename(Word_list::long_list),
+    };
+
+    pollfd fds[2] = {{inotify_fd, POLLIN, 0}, {stop_fd_, POLLIN, 0}};
+    bool changed = false;
+
+    for (;;) {
+        // Once something has changed, wait only until the writes settle.
+        int n = ::poll(fds, 2, changed ? settle_ms : collect_ms);
+        if (n < 0 && errno != EINTR) {
+            return;
+        }
+
+        if (fds[1].revents) {
+            return;
+        }
+
+        if (n > 0 && fds[0].revents) {
+            alignas(inotify_event) char buf[4096];
+            ssize_t got = ::read(inotify_fd, buf, sizeof buf);
+
+            for (ssize_t at = 0; at < got; ) {
+                auto const* event = reinterpret_cast<inotify_event*>(buf + at);
+                at += ssize_t(sizeof *event + event->len);
+
+                for (std::string const& name : names) {
+                    if (event->len && name == event->name) {
+                        changed = true;
+                    }
+                }
+            }
+            continue;
+        }
+
+        if (changed) {
+            changed = false;
+            reload();
+        } else {
+            collect();
+        }
+    }
+#else
+    (void) inotify_fd;
+#endif
+}
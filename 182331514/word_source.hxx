@@ -0,0 +1,183 @@
+#pragma once
+
+#include "anagram_index.hxx"
+#include "dictionary.hxx"
+#include "word_bank.hxx"
+#include "word_selection.hxx"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// One loaded version of the word lists, with everything Models build from
+/// a word bank: the anagram index and a selector for each difficulty. Built
+/// once and never changed; a Word_source hands them out and frees them when
+/// the last Model lets go.
+class Word_lists
+{
+public:
+
+    /// `common_count` is how many of the first words are common ones (see
+    /// difficulty_scores()).
+    Word_lists(Word_bank bank, size_t common_count);
+
+    // The index and selectors point into the bank, so it mustn't move.
+    Word_lists(Word_lists const&) = delete;
+    Word_lists& operator=(Word_lists const&) = delete;
+
+    Word_bank const& bank() const { return bank_; }
+    Anagram_index const& anagrams() const { return anagrams_; }
+    Word_selector const& selector(Difficulty tier) const;
+
+    /// This list's selector for the same curve as `other` (which is usually
+    /// an older list's), or nullptr if `other` isn't one of the tiers.
+    Word_selector const* matching_selector(Word_selector const& other) const;
+
+    /// Counts up from 1 each time the source publishes new lists.
+    uint64_t generation() const { return generation_; }
+
+private:
+
+    friend class Word_source;
+
+    Word_bank bank_;
+    Anagram_index anagrams_;
+    std::vector<double> scores_;
+    std::vector<Word_selector> selectors_;
+    uint64_t generation_;
+
+    /// How many Word_source::Refs hold these lists.
+    mutable std::atomic<long> users_;
+};
+
+/// The current word lists, which can be replaced while games are using
+/// them: when wordle-La.txt or wordle-Ta.txt changes on disk, watch()
+/// reloads them in the background, and each Model picks up the new lists at
+/// its next word (see Model::set_word_source()).
+///
+/// Taking the current lists never waits. It is a read-side critical
+/// section in the style of RCU: a reader bumps one of two counters, loads
+/// the current pointer, takes a reference, and drops the counter again, all
+/// with atomic operations. Publishing new lists swaps the pointer, then
+/// waits for each counter in turn to drain (flipping which one new readers
+/// use, so they can't keep it from draining), after which no reader can
+/// still be about to take a reference to the old lists. Those are then
+/// freed as soon as no Ref holds them, by whichever thread publishes or
+/// collects next.
+class Word_source
+{
+public:
+
+    /// Holds one version of the lists alive. Cheap to copy: one atomic
+    /// increment.
+    class Ref
+    {
+    public:
+        Ref() = default;
+        Ref(Ref const& other);
+        Ref(Ref&& other) noexcept;
+        Ref& operator=(Ref other) noexcept;
+        ~Ref();
+
+        Word_lists const* get() const { return lists_; }
+        Word_lists const& operator*() const { return *lists_; }
+        Word_lists const* operator->() const { return lists_; }
+        explicit operator bool() const { return lists_ != nullptr; }
+
+    private:
+        friend class Word_source;
+        explicit Ref(Word_lists const* lists);
+
+        Word_lists const* lists_ = nullptr;
+    };
+
+    /// Loads `list` from its files in `directory` (which, if empty, is
+    /// wherever Dictionary::resource_path() finds them). Throws
+    /// std::runtime_error if they can't be read or hold no words.
+    explicit Word_source(Word_list list, std::string directory = "");
+
+    /// A source that starts with the given words and is only ever changed
+    /// by publish(). For tests and tools.
+    explicit Word_source(Word_bank bank, size_t common_count = 0);
+
+    /// Stops watching. Every Ref must be gone by now.
+    ~Word_source();
+
+    Word_source(Word_source const&) = delete;
+    Word_source& operator=(Word_source const&) = delete;
+
+    /// The current lists. Never blocks.
+    Ref current() const;
+
+    /// The current lists' generation, to check cheaply whether current()
+    /// would return something new.
+    uint64_t generation() const;
+
+    /// Makes `bank` the current lists. Waits for readers that may have seen
+    /// the old pointer, but never for the Models holding old lists.
+    void publish(Word_bank bank, size_t common_count);
+
+    /// Reads the files again and publishes what they hold. Returns false,
+    /// keeping the current lists, if they can't be read or hold no words
+    /// (say, an editor is halfway through saving).
+    bool reload();
+
+    /// Starts a thread that calls reload() whenever one of the files is
+    /// written or replaced, and frees old lists once they're unused.
+    /// Does nothing for a source made from a Word_bank, or where there is
+    /// no inotify.
+    void watch();
+
+    /// Frees old lists no Ref holds any more. watch() does this by itself.
+    void collect();
+
+    /// Number of old lists not yet freed.
+    size_t retired_count() const;
+
+private:
+
+    Word_list list_;
+
+    /// Where the files are, ending in '/' (or empty for the working
+    /// directory); not used unless from_files_.
+    std::string directory_;
+    bool from_files_;
+
+    std::atomic<Word_lists*> current_;
+
+    /// The generation of the lists current_ points to (or is about to).
+    /// Kept apart from them, so reading it needs no reader section: the
+    /// lists themselves may be freed at any time by a writer.
+    std::atomic<uint64_t> generation_;
+
+    /// Readers in a critical section, by the parity of epoch_ they entered
+    /// under.
+    mutable std::atomic<unsigned> epoch_;
+    mutable std::atomic<long> readers_[2];
+
+    /// Held by writers (publish() and collect()) only; readers never take
+    /// it.
+    mutable std::mutex writer_mutex_;
+    std::vector<std::unique_ptr<Word_lists>> retired_;
+
+    std::thread watcher_;
+    int stop_fd_;
+
+    /// Waits until no reader can still hold a pointer loaded before the
+    /// last swap of current_.
+    void synchronize_() const;
+
+    /// Frees unused retired lists. writer_mutex_ must be held.
+    void collect_locked_();
+
+    /// The words of the files, with the number of common (short list)
+    /// ones. Throws std::runtime_error if they can't be read.
+    Word_bank read_files_(size_t& common_count) const;
+
+    /// The body of the watcher thread.
+    void watch_loop_(int inotify_fd);
+};